@@ -0,0 +1,77 @@
+// Overhead benchmark for diversity-aware survivor selection.
+//
+// Runs the genetic algorithm with elitist and with biased-fitness survivor
+// selection on data/C101.txt (when found) and on random instances, and reports
+// the time per generation, the part of it spent maintaining the broken-pairs
+// distance cache and choosing survivors, the final population diversity and
+// the best cost.
+//
+// Usage: bench_diversity [generations] [population_size]
+
+#include "vrp.hpp"
+#include "genetic_algorithm.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::vector<Node> randomInstance(int customers, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<double> coord(0.0, 1000.0);
+    std::uniform_int_distribution<int> demand(1, 10);
+    std::vector<Node> nodes;
+    nodes.reserve(customers + 1);
+    nodes.push_back({0, 500.0, 500.0, 0});
+    for (int i = 1; i <= customers; ++i)
+        nodes.push_back({i, coord(rng), coord(rng), demand(rng)});
+    return nodes;
+}
+
+static void runCase(const std::string &name, const VRP &vrp, int generations, int populationSize)
+{
+    for (SurvivorSelection method : {SurvivorSelection::Elitist, SurvivorSelection::BiasedFitness})
+    {
+        GeneticAlgorithm ga(vrp);
+        ga.setSeed(42);
+        ga.setMutationMethod(MutationMethod::RuinRecreate, 15);
+        ga.setSurvivorSelection(method);
+        ga.initializePopulation(populationSize);
+
+        auto start = std::chrono::steady_clock::now();
+        ga.run(generations);
+        double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        double msPerGeneration = totalMs / generations;
+        double overheadPerGeneration = ga.getSurvivorSelectionMs() / generations;
+
+        std::printf("%-12s %-9s %12.3f %14.3f %10.1f %10.3f %12.1f\n", name.c_str(),
+                    method == SurvivorSelection::Elitist ? "elitist" : "diversity", msPerGeneration,
+                    overheadPerGeneration, msPerGeneration > 0.0 ? 100.0 * overheadPerGeneration / msPerGeneration : 0.0,
+                    ga.getPopulationDiversity(), ga.getBestSolutionCost());
+        std::fflush(stdout);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int generations = argc > 1 ? std::atoi(argv[1]) : 200;
+    int populationSize = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    std::printf("%-12s %-9s %12s %14s %10s %10s %12s\n", "instance", "survivors", "ms_per_gen", "overhead_ms", "overhead%",
+                "diversity", "cost");
+
+    VRP c101;
+    c101.loadData("data/C101.txt");
+    if (!c101.getNodes().empty())
+        runCase("C101", c101, generations, populationSize);
+
+    std::mt19937 rng(12345);
+    for (int customers : {1000, 5000})
+    {
+        VRP vrp;
+        vrp.setData(randomInstance(customers, rng), customers / 9 + 1, 50, 20);
+        runCase("random" + std::to_string(customers), vrp, std::max(1, generations / 10), populationSize);
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Scaling benchmark for the large-instance mode.
+//
+// Generates random uniform instances of growing size, runs a few generations
+// of the genetic algorithm in large-instance mode (fixed seed, capacity
+// constraints) and reports the time and memory per generation. Both should grow near-linearly with the number of
+// customers.
+//
+// Usage: bench_scaling [max_customers] [generations]
+
+#include "vrp.hpp"
+#include "genetic_algorithm.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Reads a field such as VmRSS or VmHWM (in kB) from /proc/self/status; 0 if unavailable.
+static long readProcStatusKb(const std::string &field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, field.size(), field) == 0 && line.size() > field.size() && line[field.size()] == ':')
+            return std::atol(line.c_str() + field.size() + 1);
+    }
+    return 0;
+}
+
+static std::vector<Node> randomInstance(int customers, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<double> coord(0.0, 1000.0);
+    std::uniform_int_distribution<int> demand(1, 10);
+    std::vector<Node> nodes;
+    nodes.reserve(customers + 1);
+    nodes.push_back({0, 500.0, 500.0, 0});
+    for (int i = 1; i <= customers; ++i)
+        nodes.push_back({i, coord(rng), coord(rng), demand(rng)});
+    return nodes;
+}
+
+int main(int argc, char *argv[])
+{
+    int maxCustomers = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int generations = argc > 2 ? std::atoi(argv[2]) : 5;
+    const int populationSize = 20;
+    const int capacity = 50;
+
+    std::printf("%10s %12s %12s %16s %12s %12s\n", "customers", "setup_ms", "ms_per_gen", "us_per_gen_cust", "rss_mb", "cost");
+
+    std::mt19937 rng(12345);
+    for (int customers = 1000; customers <= maxCustomers; customers *= 10)
+    {
+        for (int size : {customers, customers * 5})
+        {
+            if (size > maxCustomers)
+                break;
+
+            auto setupStart = std::chrono::steady_clock::now();
+            VRP vrp;
+            vrp.setLargeInstanceMode(true);
+            vrp.setData(randomInstance(size, rng), size * 55 / (10 * capacity) + 1, capacity, 20);
+
+            GeneticAlgorithm ga(vrp);
+            ga.setSeed(42);
+            ga.setEvaluation(DistanceType::Double, ConstraintType::Capacity);
+            ga.setMutationMethod(MutationMethod::RuinRecreate, 20);
+            ga.initializePopulation(populationSize);
+            double setupMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - setupStart).count();
+
+            auto runStart = std::chrono::steady_clock::now();
+            ga.run(generations);
+            double runMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runStart).count();
+            double msPerGeneration = runMs / generations;
+
+            std::printf("%10d %12.1f %12.2f %16.3f %12.1f %12.0f\n", size, setupMs, msPerGeneration,
+                        1000.0 * msPerGeneration / size, readProcStatusKb("VmRSS") / 1024.0, ga.getBestSolutionCost());
+            std::fflush(stdout);
+        }
+    }
+    return 0;
+}
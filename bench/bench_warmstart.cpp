@@ -0,0 +1,117 @@
+// Convergence benchmark for warm-started re-optimization.
+//
+// Solves data/C101.txt, applies a small instance delta (a few customers
+// removed, added and moved), then re-solves the changed instance once from a
+// random population (cold) and once seeded with the remapped final population
+// of the first solve (warm). Reports, per seed, the generations and time each
+// start needs to reach a target cost: the final cold cost plus a tolerance.
+//
+// Usage: bench_warmstart [generations] [population_size] [changes] [tolerance_percent]
+
+#include "vrp.hpp"
+#include "solver.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Generations until the best cost first reaches the target, or -1.
+static int generationsToTarget(const SolveStatistics &stats, double target)
+{
+    if (stats.initialCost <= target)
+        return 0;
+    for (std::size_t gen = 0; gen < stats.bestCostHistory.size(); ++gen)
+    {
+        if (stats.bestCostHistory[gen] <= target)
+            return static_cast<int>(gen + 1);
+    }
+    return -1;
+}
+
+// Milliseconds until the target, assuming evenly spaced generations.
+static double msToTarget(const SolveStatistics &stats, int generations)
+{
+    if (generations < 0 || stats.generations == 0)
+        return -1.0;
+    return stats.elapsedMs * generations / stats.generations;
+}
+
+static InstanceDelta randomDelta(const VRP &vrp, int changes, std::mt19937 &rng)
+{
+    const int numCustomers = static_cast<int>(vrp.getNodes().size()) - 1;
+    std::vector<int> customers(numCustomers);
+    for (int i = 0; i < numCustomers; ++i)
+        customers[i] = i + 1;
+    std::shuffle(customers.begin(), customers.end(), rng);
+
+    std::uniform_real_distribution<double> coord(0.0, 100.0);
+    InstanceDelta delta;
+    for (int i = 0; i < changes; ++i)
+    {
+        delta.removed.push_back(customers[i]);
+        delta.added.push_back({1000 + i, coord(rng), coord(rng), 10});
+        Node moved = vrp.getNodes()[customers[changes + i]];
+        moved.x = coord(rng);
+        moved.y = coord(rng);
+        delta.moved.push_back({customers[changes + i], moved});
+    }
+    return delta;
+}
+
+int main(int argc, char *argv[])
+{
+    int generations = argc > 1 ? std::atoi(argv[1]) : 300;
+    int populationSize = argc > 2 ? std::atoi(argv[2]) : 50;
+    int changes = argc > 3 ? std::atoi(argv[3]) : 2;
+    double tolerance = argc > 4 ? std::atof(argv[4]) / 100.0 : 0.01;
+
+    VRP base;
+    base.loadData("data/C101.txt");
+    if (base.getNodes().empty())
+        return 1;
+
+    std::printf("%-5s %-5s %12s %12s %10s %12s %12s\n", "seed", "start", "initial", "final", "gens", "ms", "target");
+    double coldGenerations = 0.0, warmGenerations = 0.0;
+    int coldReached = 0, warmReached = 0;
+    for (unsigned int seed = 1; seed <= 5; ++seed)
+    {
+        SolverConfig config;
+        config.populationSize = populationSize;
+        config.generations = generations;
+        config.constraintType = ConstraintType::Capacity;
+        config.adaptiveOperators = false;
+        config.seed = seed;
+
+        VRP vrp = base;
+        SolveResult previous = solve(vrp, config);
+
+        std::mt19937 rng(seed);
+        InstanceDelta delta = randomDelta(vrp, changes, rng);
+        std::vector<int> indexMap = vrp.applyDelta(delta);
+        std::vector<std::vector<std::vector<int>>> seeds;
+        for (const auto &individual : previous.population)
+            seeds.push_back(VRP::remapRoutes(individual, indexMap, &delta));
+
+        SolveResult cold = solve(vrp, config);
+        SolveResult warm = solve(vrp, seeds, config);
+        double target = cold.cost * (1.0 + tolerance);
+
+        for (const SolveResult *result : {&cold, &warm})
+        {
+            int gens = generationsToTarget(result->statistics, target);
+            std::printf("%-5u %-5s %12.1f %12.1f %10d %12.1f %12.1f\n", seed, result == &cold ? "cold" : "warm",
+                        result->statistics.initialCost, result->cost, gens, msToTarget(result->statistics, gens), target);
+            if (gens >= 0)
+            {
+                (result == &cold ? coldGenerations : warmGenerations) += gens;
+                ++(result == &cold ? coldReached : warmReached);
+            }
+        }
+        std::fflush(stdout);
+    }
+    std::printf("mean generations to target: cold %.1f (%d/5 reached), warm %.1f (%d/5 reached)\n",
+                coldReached > 0 ? coldGenerations / coldReached : -1.0, coldReached,
+                warmReached > 0 ? warmGenerations / warmReached : -1.0, warmReached);
+    return 0;
+}
@@ -0,0 +1,126 @@
+#ifndef DIVERSITY_HPP
+#define DIVERSITY_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Diversity bookkeeping for the individuals of a population.
+ *
+ * Every individual is stored as successor/predecessor arrays, so the
+ * broken-pairs distance between two individuals takes O(n). Each individual
+ * also keeps the distances to all other individuals sorted ascending (its
+ * nearest-neighbors cache), updated incrementally when individuals are added
+ * or removed. Slots are kept parallel to the population vector of the caller:
+ * add() appends and remove() swaps the last slot into the removed one.
+ */
+class PopulationDiversity
+{
+public:
+    /**
+     * @brief Constructs an empty tracker.
+     *
+     * @param numNodes Number of nodes of the instance, depot included.
+     */
+    explicit PopulationDiversity(std::size_t numNodes = 0);
+
+    /**
+     * @brief Removes all individuals and sets the instance size.
+     *
+     * @param numNodes Number of nodes of the instance, depot included.
+     */
+    void reset(std::size_t numNodes);
+
+    /**
+     * @brief Appends an individual and updates the nearest-neighbors caches.
+     *
+     * O(size * n) for the distances plus O(size^2) for the cache updates.
+     *
+     * @param routes The routes of the individual.
+     */
+    void add(const std::vector<std::vector<int>> &routes);
+
+    /**
+     * @brief Removes an individual; the last slot moves into its place.
+     *
+     * @param index Slot of the individual.
+     */
+    void remove(std::size_t index);
+
+    /// Returns the number of individuals.
+    std::size_t size() const { return slots.size(); }
+
+    /**
+     * @brief Returns the average broken-pairs distance to the closest individuals.
+     *
+     * @param index Slot of the individual.
+     * @param numClosest Number of closest individuals averaged.
+     * @return The diversity contribution in [0, 1] (0 for a single individual).
+     */
+    double diversityContribution(std::size_t index, std::size_t numClosest) const;
+
+    /**
+     * @brief Returns the distance to the closest other individual.
+     *
+     * @param index Slot of the individual.
+     * @return The distance, 1 if the individual is alone.
+     */
+    double closestDistance(std::size_t index) const;
+
+    /**
+     * @brief Computes the biased fitness of every individual.
+     *
+     * fitness = cost rank + (1 - numElite / size) * diversity rank, both ranks
+     * normalized to [0, 1]; lower is better. The best numElite individuals by
+     * cost therefore always beat worse ones regardless of their diversity.
+     *
+     * @param costs Cost of every individual, parallel to the slots.
+     * @param numElite Number of individuals protected by their cost.
+     * @param numClosest Number of closest individuals in the diversity contribution.
+     * @return Biased fitness per slot.
+     */
+    std::vector<double> biasedFitness(const std::vector<double> &costs, std::size_t numElite, std::size_t numClosest) const;
+
+    /// Returns the average diversity contribution over the population.
+    double averageDiversity(std::size_t numClosest) const;
+
+    /**
+     * @brief Broken-pairs distance between two individuals given as routes.
+     *
+     * Fraction of customers whose successor in a is neither their successor nor
+     * their predecessor in b (depot links included).
+     *
+     * @param a First individual.
+     * @param b Second individual.
+     * @param numNodes Number of nodes, depot included.
+     * @return The distance in [0, 1].
+     */
+    static double brokenPairsDistance(const std::vector<std::vector<int>> &a, const std::vector<std::vector<int>> &b,
+                                      std::size_t numNodes);
+
+private:
+    /// Successor/predecessor arrays of one individual.
+    struct Links
+    {
+        std::vector<int> successor;   ///< Next node of every customer (0 = depot).
+        std::vector<int> predecessor; ///< Previous node of every customer (0 = depot).
+    };
+
+    /// One individual and its nearest-neighbors cache.
+    struct Slot
+    {
+        int id;                                    ///< Stable identifier.
+        Links links;                               ///< Route structure.
+        std::vector<std::pair<float, int>> closest; ///< (distance, id) of the others, ascending.
+    };
+
+    static void buildLinks(const std::vector<std::vector<int>> &routes, std::size_t numNodes, Links &links);
+    static double distance(const Links &a, const Links &b);
+
+    std::size_t numNodes;     ///< Nodes per individual, depot included.
+    std::vector<Slot> slots;  ///< Individuals, parallel to the caller's population.
+    int nextId = 0;           ///< Next stable identifier.
+};
+
+#endif // DIVERSITY_HPP
@@ -0,0 +1,253 @@
+#ifndef EVALUATION_HPP
+#define EVALUATION_HPP
+
+#include "vrp.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Numeric representation of distances during evaluation.
+ */
+enum class DistanceType
+{
+    Double,       ///< Exact double-precision distances.
+    Float,         ///< Single-precision distances and sums.
+    ScaledInteger, ///< Distances times 10, truncated to an integer (DIMACS / Solomon convention).
+    RoundedInteger ///< Distances rounded to the nearest integer (TSPLIB / CVRPLIB convention).
+};
+
+/**
+ * @brief Set of constraints enforced by the evaluation.
+ */
+enum class ConstraintType
+{
+    Unconstrained, ///< Distance only.
+    Capacity,      ///< CVRP: penalized load above the vehicle capacity.
+    TimeWindows    ///< VRPTW: capacity plus penalized lateness against the due dates.
+};
+
+/**
+ * @brief Penalty weights for constraint violations.
+ */
+struct ConstraintPenalties
+{
+    double capacity = 100.0; ///< Cost per unit of load above the vehicle capacity.
+    double lateness = 100.0; ///< Cost per time unit of service started after the due date.
+};
+
+/**
+ * @brief Distance policy: exact double-precision distances.
+ */
+struct DoubleDistance
+{
+    using value_type = double;
+    using sum_type = double;
+    static value_type convert(double distance) { return distance; }
+    static double toCost(sum_type value) { return value; }
+};
+
+/**
+ * @brief Distance policy: single-precision distances.
+ */
+struct FloatDistance
+{
+    using value_type = float;
+    using sum_type = float;
+    static value_type convert(double distance) { return static_cast<float>(distance); }
+    static double toCost(sum_type value) { return value; }
+};
+
+/**
+ * @brief Distance policy: distances multiplied by Scale and rounded to integers.
+ *
+ * ScaledIntegerDistance<10, true> truncates to one decimal as in the DIMACS
+ * VRPTW rules for Solomon instances (DistanceType::ScaledInteger);
+ * ScaledIntegerDistance<1, false> rounds to the nearest integer as in TSPLIB /
+ * CVRPLIB (DistanceType::RoundedInteger). Sums are exact.
+ *
+ * @tparam Scale Multiplier applied before rounding.
+ * @tparam Truncate Whether to truncate (true) or round to nearest (false).
+ */
+template <int Scale, bool Truncate>
+struct ScaledIntegerDistance
+{
+    using value_type = std::int32_t;
+    using sum_type = std::int64_t;
+    static value_type convert(double distance)
+    {
+        double scaled = distance * Scale;
+        return static_cast<value_type>(Truncate ? scaled : scaled + 0.5);
+    }
+    static double toCost(sum_type value) { return static_cast<double>(value) / Scale; }
+};
+
+/**
+ * @brief Distance source: a row-major matrix owned by someone else.
+ *
+ * Reads the dense matrix of the instance or a mapped matrix file without
+ * copying it.
+ *
+ * @tparam Entry Type of the stored entries.
+ */
+template <class Entry>
+struct MatrixSource
+{
+    using entry_type = Entry;
+    const Entry *values = nullptr; ///< First entry of the matrix.
+    std::size_t n = 0;             ///< Number of rows (and columns).
+    entry_type get(int from, int to) const { return values[static_cast<std::size_t>(from) * n + to]; }
+};
+
+/**
+ * @brief Distance source: the instance's distances converted once by a distance policy.
+ *
+ * Keeps a matrix of Distance::value_type, so lookups need no conversion and
+ * narrower types use less cache.
+ *
+ * @tparam Distance Distance policy doing the conversion.
+ */
+template <class Distance>
+struct ConvertedMatrixSource
+{
+    using entry_type = typename Distance::value_type;
+    std::vector<entry_type> values; ///< Row-major converted matrix.
+    std::size_t n = 0;              ///< Number of rows (and columns).
+
+    explicit ConvertedMatrixSource(const VRP &vrp) : n(vrp.getNodes().size())
+    {
+        values.resize(n * n);
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+                values[i * n + j] = Distance::convert(vrp.dist(static_cast<int>(i), static_cast<int>(j)));
+    }
+    entry_type get(int from, int to) const { return values[static_cast<std::size_t>(from) * n + to]; }
+};
+
+/**
+ * @brief Distance source: Euclidean distances computed from the coordinates.
+ *
+ * Used in large-instance mode, where no matrix is kept.
+ */
+struct EuclideanSource
+{
+    using entry_type = double;
+    std::vector<double> xs; ///< X coordinates by node index.
+    std::vector<double> ys; ///< Y coordinates by node index.
+
+    explicit EuclideanSource(const VRP &vrp)
+    {
+        for (const Node &node : vrp.getNodes())
+        {
+            xs.push_back(node.x);
+            ys.push_back(node.y);
+        }
+    }
+    entry_type get(int from, int to) const
+    {
+        double dx = xs[from] - xs[to];
+        double dy = ys[from] - ys[to];
+        return std::sqrt(dx * dx + dy * dy);
+    }
+};
+
+/**
+ * @brief Travel-time source: travel times equal the evaluated distances.
+ *
+ * The default for time windows, as in the Solomon instances; a mapped
+ * travel-time matrix is read through a MatrixSource instead.
+ */
+struct DistanceTravelTimes
+{
+};
+
+/**
+ * @brief Constraint policy: no constraints.
+ */
+struct NoConstraints
+{
+    static constexpr bool usesLoad = false;      ///< Whether the load is tracked.
+    static constexpr bool orderDependent = false; ///< Whether reversing a segment changes feasibility.
+};
+
+/**
+ * @brief Constraint policy: vehicle capacity (CVRP).
+ */
+struct CapacityConstraints
+{
+    static constexpr bool usesLoad = true;
+    static constexpr bool orderDependent = false;
+};
+
+/**
+ * @brief Constraint policy: vehicle capacity and time windows (VRPTW).
+ *
+ * Travel times equal the evaluated distances, as in the Solomon instances,
+ * unless the instance has its own travel-time matrix (VRP::loadDurationMatrix()).
+ */
+struct TimeWindowConstraints
+{
+    static constexpr bool usesLoad = true;
+    static constexpr bool orderDependent = true;
+};
+
+/**
+ * @brief Route evaluation and route-level local search of the solver.
+ *
+ * The concrete cores are templates over a distance policy, a constraint
+ * policy, a distance source (dense matrix, converted matrix or computed from
+ * coordinates), a travel-time source and the symmetry of the distances, all
+ * picked once by makeEvaluationCore(). Virtual dispatch happens once per
+ * route or solution; the move evaluation loops inside are fully specialized and
+ * contain no checks for inactive constraints, asymmetry or separate travel times.
+ */
+class EvaluationCore
+{
+public:
+    virtual ~EvaluationCore() = default;
+
+    /**
+     * @brief Returns the cost of one route: distance plus constraint penalties.
+     *
+     * @param route Customer indices; the depot is implicit at both ends.
+     * @return The cost.
+     */
+    virtual double routeCost(const std::vector<int> &route) const = 0;
+
+    /**
+     * @brief Returns the cost of a whole solution.
+     *
+     * @param routes The routes of the solution.
+     * @return The sum of the route costs.
+     */
+    virtual double solutionCost(const std::vector<std::vector<int>> &routes) const = 0;
+
+    /**
+     * @brief Improves a route with 2-opt until no improving move is left.
+     *
+     * Uses all segment reversals, or in large-instance mode only those that
+     * connect a node to one of its nearest neighbors. With asymmetric
+     * distances the cost of traversing the reversed segment backwards is
+     * included, in O(1) per move from prefix sums over the route.
+     *
+     * @param route The route to improve.
+     */
+    virtual void twoOpt(std::vector<int> &route) const = 0;
+};
+
+/**
+ * @brief Creates the evaluation core specialized for the given policies.
+ *
+ * @param vrp The instance; must outlive the core and must not change while it is used
+ *            (create a new core after VRP::applyDelta()).
+ * @param distanceType Distance representation.
+ * @param constraintType Enforced constraints.
+ * @param penalties Penalty weights for constraint violations.
+ * @return The specialized core.
+ */
+std::unique_ptr<EvaluationCore> makeEvaluationCore(const VRP &vrp, DistanceType distanceType, ConstraintType constraintType,
+                                                   const ConstraintPenalties &penalties = ConstraintPenalties());
+
+#endif // EVALUATION_HPP
@@ -2,6 +2,11 @@
 #define GENETIC_ALGORITHM_HPP
 
 #include "vrp.hpp"
+#include "operator_scheduler.hpp"
+#include "evaluation.hpp"
+#include "diversity.hpp"
+#include "route_pool.hpp"
+#include <memory>
 #include <vector>
 #include <random>
 
@@ -14,6 +19,24 @@ enum class SelectionMethod
     Roulette
 };
 
+/**
+ * @brief Enum to specify the mutation operator used in reproduce().
+ */
+enum class MutationMethod
+{
+    Swap,         ///< Swap two customers inside one random route.
+    RuinRecreate  ///< Remove a correlated set of customers and reinsert them greedily.
+};
+
+/**
+ * @brief Enum to specify how the next generation is chosen.
+ */
+enum class SurvivorSelection
+{
+    Elitist,      ///< Keep the 10 cheapest individuals and refill with offspring.
+    BiasedFitness ///< Add the offspring, then remove clones and the worst biased fitness (cost rank + diversity rank).
+};
+
 /**
  * @brief Class implementing a basic Genetic Algorithm for VRP.
  *
@@ -30,7 +53,7 @@ public:
      * @param selMethod Selection method to be used (default Tournament).
      * @param tourSize Tournament size for tournament selection (default 3).
      */
-    explicit GeneticAlgorithm(VRP &vrp, SelectionMethod selMethod = SelectionMethod::Tournament, int tourSize = 3);
+    explicit GeneticAlgorithm(const VRP &vrp, SelectionMethod selMethod = SelectionMethod::Tournament, int tourSize = 3);
 
     /// Default destructor.
     ~GeneticAlgorithm() = default;
@@ -45,6 +68,44 @@ public:
      */
     void initializePopulation(int populationSize);
 
+    /**
+     * @brief Initializes the population from previous solutions (warm start).
+     *
+     * Meant for re-solving an instance after VRP::applyDelta(): the seeds are
+     * solutions of the previous instance translated with VRP::remapRoutes().
+     * Every seed is repaired (unknown and duplicate indices are dropped, routes
+     * beyond the number of vehicles are dissolved), the customers it misses,
+     * such as newly added ones, are put in by cheapest insertion and its routes
+     * are improved with 2-opt. Missing
+     * individuals are ruin-and-recreate variants of the seeds. Without seeds
+     * this falls back to the random initialization.
+     *
+     * @param seeds Previous solutions or population, in the current node indices.
+     * @param populationSize Number of solutions in the initial population.
+     */
+    void initializePopulation(const std::vector<std::vector<std::vector<int>>> &seeds, int populationSize);
+
+    /**
+     * @brief Adds a solution from outside (e.g. a migrant from another island).
+     *
+     * The solution is repaired like a warm-start seed and then competes with
+     * the population: it replaces the worst individual (Elitist) or goes
+     * through survivor selection (BiasedFitness), so the population size is
+     * unchanged.
+     *
+     * @param routes The solution, in the current node indices.
+     */
+    void injectSolution(std::vector<std::vector<int>> routes);
+
+    /**
+     * @brief Returns the current population.
+     *
+     * Can be kept to warm-start the next solve of a changed instance.
+     *
+     * @return A constant reference to the individuals.
+     */
+    const std::vector<std::vector<std::vector<int>>> &getPopulation() const;
+
     /**
      * @brief Runs the genetic algorithm for a given number of generations.
      *
@@ -66,56 +127,243 @@ public:
      */
     double getBestSolutionCost() const;
 
+    /**
+     * @brief Selects the mutation operator applied to offspring.
+     *
+     * @param method Mutation operator to use.
+     * @param removalSize Number of customers removed by the ruin-and-recreate operator (default 10).
+     */
+    void setMutationMethod(MutationMethod method, int removalSize = 10);
+
+    /**
+     * @brief Enables or disables adaptive operator selection.
+     *
+     * When enabled, the crossover, mutation and 2-opt rates are adapted every
+     * generation from each operator's improvement per millisecond.
+     *
+     * @param enabled Whether operator rates are adapted.
+     */
+    void setAdaptiveOperators(bool enabled);
+
+    /**
+     * @brief Returns the operator scheduler with the per-operator statistics.
+     *
+     * @return A constant reference to the scheduler.
+     */
+    const OperatorScheduler &getOperatorScheduler() const;
+
+    /**
+     * @brief Reseeds the random number generator.
+     *
+     * By default the generator is seeded from the clock; a fixed seed makes
+     * runs reproducible.
+     *
+     * @param seed The seed.
+     */
+    void setSeed(unsigned int seed);
+
+    /**
+     * @brief Selects the survivor selection method.
+     *
+     * With BiasedFitness the population keeps a broken-pairs distance cache and
+     * every generation removes clones first, then the individuals with the
+     * worst biased fitness, until the population is back to its size.
+     *
+     * @param method Survivor selection method.
+     * @param numElite Individuals protected by their cost rank (default 4).
+     * @param numClosest Closest individuals in the diversity contribution (default 5).
+     */
+    void setSurvivorSelection(SurvivorSelection method, int numElite = 4, int numClosest = 5);
+
+    /**
+     * @brief Returns the average broken-pairs distance of the individuals to their closest ones.
+     *
+     * @return Diversity in [0, 1]; 0 means the population consists of clones.
+     */
+    double getPopulationDiversity() const;
+
+    /**
+     * @brief Returns the total time spent in biased-fitness survivor selection.
+     *
+     * Covers the diversity cache updates and the survivor choice, i.e. the
+     * overhead of SurvivorSelection::BiasedFitness over plain elitism.
+     *
+     * @return Time in milliseconds.
+     */
+    double getSurvivorSelectionMs() const;
+
+    /**
+     * @brief Enables route-pool recombination.
+     *
+     * Routes enter the pool where the algorithm evaluates them anyway: routes
+     * improved by 2-opt in an offspring, elites after their 2-opt, seeds and
+     * injected solutions (only the cheapest route per customer set is kept). Every interval
+     * generations RoutePool::assemble() recombines pool routes into a new
+     * solution; missing customers are inserted, and the result is injected
+     * into the population. Passing the same pool to several runs lets them
+     * share routes.
+     *
+     * @param pool The pool, or nullptr to disable; reset if it was built for another instance or revision.
+     * @param interval Generations between two recombinations (default 20).
+     */
+    void setRoutePool(std::shared_ptr<RoutePool> pool, int interval = 20);
+
+    /// Returns the route pool, or nullptr when disabled.
+    const RoutePool *getRoutePool() const { return routePool.get(); }
+
+    /// Returns how often a recombined solution improved the best solution.
+    int getSetPartitioningImprovements() const { return setPartitioningImprovements; }
+
+    /**
+     * @brief Selects the distance representation and the constraint set.
+     *
+     * The evaluation and 2-opt core is instantiated once for the chosen
+     * combination (default: double distances, no constraints). An existing
+     * population is re-evaluated with the new core.
+     *
+     * @param distanceType Distance representation.
+     * @param constraintType Enforced constraints.
+     * @param penalties Penalty weights for constraint violations.
+     */
+    void setEvaluation(DistanceType distanceType, ConstraintType constraintType,
+                       const ConstraintPenalties &penalties = ConstraintPenalties());
+
 private:
-    VRP &vrp; ///< Reference to the VRP instance.
+    const VRP &vrp; ///< Reference to the VRP instance.
     std::vector<std::vector<int>> bestSolution;
     std::vector<std::vector<std::vector<int>>> population; ///< Best solution found.
+    std::vector<double> populationCosts;                   ///< Cost of every individual, parallel to population.
+    std::vector<double> rouletteCumulative;                ///< Cumulative roulette fitness, parallel to population.
     double bestCost;                                       ///< Cost of the best solution.
     mutable std::mt19937 rng;                              ///< Mersenne Twister random number generator (mutable to allow use in const methods).
 
     SelectionMethod selectionMethod; ///< Current selection method.
     int tournamentSize;              ///< Tournament size for tournament selection.
+    MutationMethod mutationMethod = MutationMethod::Swap; ///< Current mutation operator.
+    int ruinRemovalSize = 10;        ///< Customers removed per ruin-and-recreate step.
+    OperatorScheduler scheduler;     ///< Operator rates and throughput statistics.
+    std::unique_ptr<EvaluationCore> evaluation; ///< Policy-specialized evaluation and 2-opt core.
+    SurvivorSelection survivorSelection = SurvivorSelection::Elitist; ///< Current survivor selection.
+    std::size_t numEliteSurvivors = 4;   ///< Individuals protected by cost in the biased fitness.
+    std::size_t numClosestNeighbors = 5; ///< Closest individuals in the diversity contribution.
+    PopulationDiversity diversity;       ///< Distance cache, parallel to population (BiasedFitness only).
+    double survivorSelectionMs = 0.0;    ///< Time spent in biased-fitness survivor selection.
+    std::shared_ptr<RoutePool> routePool; ///< Route pool (nullptr when disabled).
+    int setPartitioningInterval = 20;     ///< Generations between two recombinations.
+    int generationsRun = 0;               ///< Generations run so far.
+    int setPartitioningImprovements = 0;  ///< Recombinations that improved the best solution.
+    mutable std::vector<int> positionScratch; ///< Reused node -> position map of the insertion.
+    mutable std::vector<int> routeScratch;    ///< Reused node -> route map of the operators.
     /**
      * @brief Evaluates the cost of a given solution.
      *
-     * @param solution A vector of node indices representing a route.
-     * @return The computed cost of the route.
+     * Distance plus constraint penalties, as computed by the evaluation core.
+     *
+     * @param routes The routes of the solution.
+     * @return The computed cost of the solution.
      */
     double evaluateSolution(const std::vector<std::vector<int>> &routes) const;
 
+    /**
+     * @brief Evaluates a solution route by route and offers the routes to the route pool.
+     *
+     * Same cost as evaluateSolution(); without a route pool it is the same call.
+     *
+     * @param routes The routes of the solution.
+     * @return The computed cost of the solution.
+     */
+    double evaluateAndPool(const std::vector<std::vector<int>> &routes);
+
     /**
      * @brief Performs reproduction to generate a new generation.
      *
-     * Uses the current selection method to choose parents, applies mutation,
-     * and incorporates elitism by preserving the best solution.
+     * Uses the current selection method to choose parents, applies crossover,
+     * mutation and 2-opt with the rates given by the operator scheduler, and
+     * picks the survivors with the configured survivor selection.
      */
     void reproduce();
 
+    /**
+     * @brief Creates one offspring from two selected parents.
+     *
+     * Applies crossover, mutation and 2-opt with the scheduler's rates and
+     * records their statistics. The parents' costs come from populationCosts
+     * and the 2-opt route deltas are added to the offspring cost, so only the
+     * operators that rebuild the offspring re-evaluate it.
+     *
+     * @param offspringCost Receives the cost of the offspring.
+     * @return The offspring.
+     */
+    std::vector<std::vector<int>> makeOffspring(double &offspringCost);
+
+    /// Assembles a solution from the route pool and injects it into the population.
+    void recombineRoutes();
+
+    /**
+     * @brief Makes a seed solution complete and valid for the current instance.
+     *
+     * @param routes The seed; repaired in place.
+     */
+    void repairSolution(std::vector<std::vector<int>> &routes) const;
+
+    /**
+     * @brief Appends an individual to the population (and the diversity cache).
+     *
+     * @param routes The individual.
+     * @param cost Its cost.
+     */
+    void addIndividual(std::vector<std::vector<int>> routes, double cost);
+
+    /**
+     * @brief Removes an individual; the last one moves into its slot.
+     *
+     * @param index Slot of the individual.
+     */
+    void removeIndividual(std::size_t index);
+
+    /**
+     * @brief Shrinks the population to a target size by biased fitness.
+     *
+     * @param targetSize Population size to reach.
+     */
+    void selectSurvivors(std::size_t targetSize);
+
+    /// Rebuilds the diversity cache from the current population.
+    void rebuildDiversity();
+
     /**
      * @brief Selects one parent solution using the configured selection method.
      *
-     * @return A vector of node indices representing the selected parent.
+     * @return The population index of the selected parent, whose cost is cached in populationCosts.
      */
-    std::vector<std::vector<int>> selectParent() const;
+    std::size_t selectParent() const;
 
     /**
      * @brief Implements tournament selection.
      *
      * Randomly picks 'tournamentSize' individuals from the population and returns the best.
      *
-     * @return The selected parent's gene (route).
+     * @return The population index of the selected parent.
      */
-    std::vector<std::vector<int>> tournamentSelection() const;
+    std::size_t tournamentSelection() const;
 
     /**
      * @brief Implements roulette selection.
      *
-     * Calculates selection probabilities based on fitness (defined as 1/cost)
-     * and returns the selected parent's gene (route).
+     * Selection probabilities are based on fitness (defined as 1/cost), taken
+     * from the cumulative fitness cached by updateSelectionCache().
      *
-     * @return The selected parent's gene (route).
+     * @return The population index of the selected parent.
      */
-    std::vector<std::vector<int>> rouletteSelection() const;
+    std::size_t rouletteSelection() const;
+
+    /**
+     * @brief Rebuilds the cumulative fitness used by roulette selection.
+     *
+     * Called whenever the population changes, so a roulette pick is a binary
+     * search instead of a pass over the whole population.
+     */
+    void updateSelectionCache();
 
     /**
      * @brief Performs PMX (Partially Mapped Crossover) between two parent solutions.
@@ -138,10 +386,38 @@ private:
      */
     void mutate(std::vector<std::vector<int>> &routes) const;
 
+    /**
+     * @brief Ruin-and-recreate mutation (SISR-style large neighborhood step).
+     *
+     * Picks a random seed customer and removes up to ruinRemovalSize customers
+     * correlated with it: either its nearest neighbors (spatial removal) or short
+     * strings of consecutive customers around those neighbors (string removal).
+     * The removed customers are then put back with insertCustomers().
+     *
+     * @param routes The solution to be mutated.
+     */
+    void ruinRecreate(std::vector<std::vector<int>> &routes) const;
+
+    /**
+     * @brief Reinserts customers into a solution using cheapest insertion.
+     *
+     * Customers are inserted one by one at the position with the lowest
+     * insertion cost among the routes that still have capacity slack for them.
+     * If no route has enough slack, the overall cheapest position is used. In
+     * large-instance mode only positions next to the customer's neighbors and
+     * one empty route are evaluated.
+     *
+     * @param routes The solution receiving the customers.
+     * @param customers The customers to insert.
+     */
+    void insertCustomers(std::vector<std::vector<int>> &routes, std::vector<int> &customers) const;
+
     /**
      * @brief Applies the 2-opt local search algorithm to improve a given route.
      *
      * The algorithm iteratively swaps two edges in the route to reduce the total cost.
+     * Delegates to the evaluation core, which restricts the moves to the neighbor
+     * lists in large-instance mode.
      *
      * @param route The route to be improved.
      */
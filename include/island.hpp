@@ -0,0 +1,353 @@
+#ifndef ISLAND_HPP
+#define ISLAND_HPP
+
+#include "vrp.hpp"
+#include "solver.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Elite solution received from another island.
+ */
+struct Migrant
+{
+    std::vector<std::vector<int>> routes; ///< The solution (node indices, depot omitted).
+    double cost = 0.0;                    ///< Cost reported by the sending island.
+};
+
+/**
+ * @brief Channel through which an island exchanges elites with the others.
+ *
+ * Solutions travel in the compact binary solution format of encodeSolution().
+ * Every island runs its own GeneticAlgorithm in its own process, so the
+ * islands share no heap.
+ */
+class MigrationChannel
+{
+public:
+    virtual ~MigrationChannel() = default;
+
+    /**
+     * @brief Sends the island's best solution to the other islands.
+     *
+     * @param routes The solution.
+     * @param cost Its cost.
+     */
+    virtual void publish(const std::vector<std::vector<int>> &routes, double cost) = 0;
+
+    /**
+     * @brief Collects the elites that arrived since the last call, without blocking.
+     *
+     * @param migrants Receives the solutions (appended).
+     */
+    virtual void receive(std::vector<Migrant> &migrants) = 0;
+
+    /// Returns whether the coordinator asked the island to stop.
+    virtual bool stopRequested() = 0;
+};
+
+/**
+ * @brief Elite exchange between processes on one host over POSIX shared memory.
+ *
+ * The segment holds one ring buffer per island, each written only by its
+ * island, and a stop flag. Every ring slot is guarded by a sequence lock:
+ * the writer makes the sequence odd while it copies a solution in, and a
+ * reader discards a slot whose sequence was odd or changed during its copy,
+ * so neither side ever blocks. A reader that falls behind by more than a
+ * ring length skips to the newest solutions.
+ */
+class SharedMemoryExchange : public MigrationChannel
+{
+public:
+    /**
+     * @brief Creates or opens a shared-memory segment.
+     *
+     * @param name Segment name (e.g. "/vrp_ea_1234").
+     * @param numIslands Number of islands (rings).
+     * @param island Index of the island using this object.
+     * @param slotSize Largest encoded solution in bytes, see slotSizeFor().
+     * @param create Whether to create the segment (the coordinator) or open an existing one.
+     * @throws std::runtime_error If the segment cannot be created, opened or mapped.
+     */
+    SharedMemoryExchange(const std::string &name, int numIslands, int island, std::size_t slotSize, bool create);
+
+    /// Unmaps the segment; the creator also removes it.
+    ~SharedMemoryExchange() override;
+
+    SharedMemoryExchange(const SharedMemoryExchange &) = delete;
+    SharedMemoryExchange &operator=(const SharedMemoryExchange &) = delete;
+
+    void publish(const std::vector<std::vector<int>> &routes, double cost) override;
+    void receive(std::vector<Migrant> &migrants) override;
+    bool stopRequested() override;
+
+    /// Sets the stop flag seen by all islands.
+    void requestStop();
+
+    /**
+     * @brief Returns a slot size large enough for any solution of an instance.
+     *
+     * @param vrp The instance.
+     * @return Slot size in bytes.
+     */
+    static std::size_t slotSizeFor(const VRP &vrp);
+
+private:
+    struct SegmentHeader;
+    struct RingHeader;
+    struct SlotHeader;
+
+    RingHeader *ring(int index) const;
+    SlotHeader *slot(int ringIndex, std::uint64_t position) const;
+
+    std::string name;                 ///< Segment name.
+    bool owner;                       ///< Whether this object created the segment.
+    int island;                       ///< Index of the own ring.
+    std::size_t slotSize;             ///< Payload bytes per slot.
+    std::size_t slotStride;           ///< Bytes per slot including its header.
+    std::size_t ringStride;           ///< Bytes per ring including its header.
+    std::size_t mappedSize = 0;       ///< Size of the mapping.
+    unsigned char *base = nullptr;    ///< Start of the mapping.
+    SegmentHeader *header = nullptr;  ///< Segment header at the start of the mapping.
+    std::vector<std::uint64_t> readPositions; ///< Next message to read from every ring.
+    std::string buffer;               ///< Reused encode/decode buffer.
+};
+
+/**
+ * @brief Coordinator side of the TCP elite exchange.
+ *
+ * Accepts worker connections, merges the elites they send into a global best
+ * and forwards every improvement of it to all workers. requestStop() sends
+ * the stop signal; collectFinal() then gathers the last elites.
+ *
+ * Sockets are non-blocking: outgoing frames are queued per connection and
+ * flushed whenever the coordinator reads, so it never blocks on a worker that
+ * is itself busy sending. A worker that falls more than 64 MiB behind misses
+ * elites (newer ones supersede them) but still gets the stop signal.
+ */
+class TcpCoordinator : public MigrationChannel
+{
+public:
+    /**
+     * @brief Listens for workers on a port.
+     *
+     * @param port TCP port (all interfaces).
+     * @param fingerprint islandFingerprint() of the coordinator; workers that greet with another one are rejected.
+     * @throws std::runtime_error If the port cannot be bound.
+     */
+    TcpCoordinator(int port, std::uint64_t fingerprint);
+
+    /// Closes all connections.
+    ~TcpCoordinator() override;
+
+    TcpCoordinator(const TcpCoordinator &) = delete;
+    TcpCoordinator &operator=(const TcpCoordinator &) = delete;
+
+    /**
+     * @brief Waits until a number of workers has connected and sent its hello.
+     *
+     * @param count Workers to wait for.
+     * @param timeoutMs Maximum wait in milliseconds.
+     * @return Number of connected workers with a matching instance.
+     */
+    std::size_t waitForWorkers(std::size_t count, int timeoutMs);
+
+    void publish(const std::vector<std::vector<int>> &routes, double cost) override;
+    void receive(std::vector<Migrant> &migrants) override;
+    bool stopRequested() override { return false; }
+
+    /// Sends the stop signal to all workers.
+    void requestStop();
+
+    /**
+     * @brief Reads the remaining elites until every worker has disconnected.
+     *
+     * @param migrants Receives the solutions (appended).
+     * @param timeoutMs Maximum wait in milliseconds.
+     */
+    void collectFinal(std::vector<Migrant> &migrants, int timeoutMs);
+
+private:
+    struct Connection
+    {
+        int fd = -1;        ///< Socket.
+        std::string inbox;  ///< Received bytes not yet parsed into frames.
+        std::string outbox; ///< Frames not yet taken by the socket.
+        bool greeted = false; ///< Whether the hello frame was accepted.
+    };
+
+    void acceptPending();
+    /// Reads and flushes all connections; drops the ones that closed.
+    void readConnections(std::vector<Migrant> &migrants);
+    /// Waits until a connection is readable or writable (or a worker connects), then serves them.
+    void pollConnections(int timeoutMs);
+    /// Queues a frame for every greeted worker but one.
+    void broadcast(char type, const std::string &payload, int exceptFd);
+    std::size_t greetedWorkers() const;
+
+    int listenFd = -1;                    ///< Listening socket.
+    std::uint64_t fingerprint;            ///< Expected islandFingerprint() of the workers.
+    std::vector<Connection> connections;  ///< Connected workers.
+    std::vector<Migrant> early;           ///< Elites read outside receive(), handed out by the next call.
+    double bestCost;                      ///< Cost of the best elite seen.
+};
+
+/**
+ * @brief Worker side of the TCP elite exchange.
+ *
+ * Like the coordinator, queues outgoing frames and sends them without
+ * blocking; the queue is flushed on every publish(), receive() and
+ * stopRequested() call.
+ */
+class TcpWorker : public MigrationChannel
+{
+public:
+    /**
+     * @brief Connects to a coordinator, retrying while it is not listening yet.
+     *
+     * @param host Host name or address of the coordinator.
+     * @param port TCP port of the coordinator.
+     * @param fingerprint islandFingerprint() of the worker, checked by the coordinator.
+     * @param timeoutMs Maximum time to keep retrying, in milliseconds.
+     * @throws std::runtime_error If no connection could be made.
+     */
+    TcpWorker(const std::string &host, int port, std::uint64_t fingerprint, int timeoutMs = 10000);
+
+    /// Sends the queued frames (waiting up to 10 seconds) and closes the connection.
+    ~TcpWorker() override;
+
+    TcpWorker(const TcpWorker &) = delete;
+    TcpWorker &operator=(const TcpWorker &) = delete;
+
+    void publish(const std::vector<std::vector<int>> &routes, double cost) override;
+    void receive(std::vector<Migrant> &migrants) override;
+    bool stopRequested() override;
+
+private:
+    /// Parses the frames that arrived; elites are kept for the next receive().
+    void readFrames();
+
+    int fd = -1;                 ///< Socket.
+    std::string inbox;           ///< Received bytes not yet parsed into frames.
+    std::string outbox;          ///< Frames not yet taken by the socket.
+    std::vector<Migrant> pending; ///< Elites parsed but not yet handed out.
+    bool stopped = false;        ///< Whether a stop frame arrived or the coordinator went away.
+};
+
+/**
+ * @brief Runs one island: a solve() loop that exchanges elites through a channel.
+ *
+ * Every migrationInterval generations the island publishes its best solution
+ * and injects the received ones into its population. It stops on its own
+ * generation or time budget, on cancellation, or when the channel reports a
+ * stop request, and finally publishes its best solution once more.
+ *
+ * @param vrp The instance.
+ * @param config Solver configuration.
+ * @param channel Elite exchange.
+ * @param migrationInterval Generations between two exchanges.
+ * @param token Optional cancellation token.
+ * @return The island's best solution with statistics.
+ */
+SolveResult runIsland(const VRP &vrp, const SolverConfig &config, MigrationChannel &channel,
+                      int migrationInterval = 10, const CancellationToken *token = nullptr);
+
+/**
+ * @brief Returns a fingerprint of everything that defines the cost of a solution.
+ *
+ * Hashes the nodes, the fleet, the distance and constraint types, the
+ * penalties and a sample of the entries of external matrices. Islands only
+ * cooperate when their fingerprints match, so that their costs are comparable.
+ *
+ * @param vrp The instance.
+ * @param config Solver configuration.
+ * @return The fingerprint.
+ */
+std::uint64_t islandFingerprint(const VRP &vrp, const SolverConfig &config);
+
+/// Argument appended to the worker command by solveLocalIslands(), followed by the island specification.
+inline constexpr char SharedMemoryIslandOption[] = "--shm-island=";
+
+/**
+ * @brief Solves with several island processes on this host.
+ *
+ * Starts numIslands - 1 worker processes with posix_spawn() that exchange
+ * elites with the calling process over a SharedMemoryExchange. Every worker
+ * runs workerCommand with one more argument: SharedMemoryIslandOption
+ * followed by the island specification, which the started program passes to
+ * runSharedMemoryWorker(). The program must load the same instance and
+ * configuration as the caller; main() uses its own path and arguments. The
+ * workers' standard output is discarded.
+ * Since the workers are exec'ed rather than forked, this is safe to call from
+ * multi-threaded hosts, and concurrent calls use separate segments.
+ *
+ * The calling process is island 0 and the coordinator: when its own run ends
+ * it raises the stop flag, waits for the workers and injects their final
+ * solutions into its own population, so they are repaired and re-scored
+ * before the best one is returned. Island i uses seed config.seed + i (all
+ * clock-seeded when config.seed is 0).
+ *
+ * @param vrp The instance.
+ * @param config Solver configuration of every island.
+ * @param numIslands Number of processes, including the calling one.
+ * @param workerCommand Program (looked up in PATH when it has no slash) and its arguments.
+ * @param migrationInterval Generations between two exchanges.
+ * @param token Optional cancellation token (checked by the coordinator).
+ * @return The best solution over all islands; statistics and population are the coordinator's.
+ * @throws std::runtime_error If the shared memory or a process cannot be created.
+ * @throws std::invalid_argument If workerCommand is empty.
+ */
+SolveResult solveLocalIslands(const VRP &vrp, const SolverConfig &config, int numIslands,
+                              const std::vector<std::string> &workerCommand, int migrationInterval = 10,
+                              const CancellationToken *token = nullptr);
+
+/**
+ * @brief Runs a worker island started by solveLocalIslands().
+ *
+ * @param vrp The instance; must be the coordinator's instance.
+ * @param config Solver configuration; the seed is replaced by the island's own.
+ * @param spec The argument after SharedMemoryIslandOption.
+ * @param token Optional cancellation token.
+ * @return The worker's best solution with statistics.
+ * @throws std::invalid_argument If spec is malformed, or the instance or configuration differs from the coordinator's.
+ * @throws std::runtime_error If the segment cannot be opened or has a different layout.
+ */
+SolveResult runSharedMemoryWorker(const VRP &vrp, const SolverConfig &config, const std::string &spec,
+                                  const CancellationToken *token = nullptr);
+
+/**
+ * @brief Runs the coordinator island of a TCP island run.
+ *
+ * Waits up to 30 seconds for numWorkers workers, runs island 0, then stops
+ * the workers and injects their final elites into its population, where they
+ * are repaired and re-scored. Workers whose islandFingerprint() differs are
+ * rejected when they connect.
+ *
+ * @param vrp The instance.
+ * @param config Solver configuration.
+ * @param port TCP port to listen on.
+ * @param numWorkers Number of workers to wait for.
+ * @param migrationInterval Generations between two exchanges.
+ * @param token Optional cancellation token.
+ * @return The best solution over all islands; statistics and population are the coordinator's.
+ */
+SolveResult runTcpCoordinator(const VRP &vrp, const SolverConfig &config, int port, int numWorkers,
+                              int migrationInterval = 10, const CancellationToken *token = nullptr);
+
+/**
+ * @brief Runs a worker island of a TCP island run until the coordinator stops it.
+ *
+ * @param vrp The instance; must be the coordinator's instance.
+ * @param config Solver configuration.
+ * @param host Host of the coordinator.
+ * @param port Port of the coordinator.
+ * @param migrationInterval Generations between two exchanges.
+ * @param token Optional cancellation token.
+ * @return The worker's best solution with statistics.
+ */
+SolveResult runTcpWorker(const VRP &vrp, const SolverConfig &config, const std::string &host, int port,
+                         int migrationInterval = 10, const CancellationToken *token = nullptr);
+
+#endif // ISLAND_HPP
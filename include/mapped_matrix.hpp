@@ -0,0 +1,107 @@
+#ifndef MAPPED_MATRIX_HPP
+#define MAPPED_MATRIX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Value type of the entries of a matrix file.
+ */
+enum class MatrixValueType : std::uint32_t
+{
+    Float32 = 0, ///< IEEE-754 single precision.
+    Float64 = 1  ///< IEEE-754 double precision.
+};
+
+/**
+ * @brief Read-only square matrix memory-mapped from a binary file.
+ *
+ * Holds external distance or travel-time matrices (e.g. from a road-network
+ * routing engine) without copying them into the heap; the operating system
+ * pages the rows in as they are used. Entry (i, j) is the cost of going from
+ * node i to node j, so the matrix may be asymmetric.
+ *
+ * File layout (host byte order, little-endian on all supported platforms):
+ * a 32-byte header of magic "VRPM", uint32 version (1), uint32 value type
+ * (MatrixValueType), uint32 flags (bit 0: the matrix is symmetric), uint64
+ * number of nodes n and 8 reserved bytes, followed by the n * n entries in
+ * row-major order.
+ */
+class MappedMatrix
+{
+public:
+    /// Flag bit marking a symmetric matrix.
+    static constexpr std::uint32_t SymmetricFlag = 1u;
+
+    /**
+     * @brief Maps a matrix file.
+     *
+     * @param path Path of the file.
+     * @throws std::runtime_error If the file cannot be opened or mapped, or its header or size is invalid.
+     */
+    explicit MappedMatrix(const std::string &path);
+
+    /// Unmaps the file.
+    ~MappedMatrix();
+
+    MappedMatrix(const MappedMatrix &) = delete;
+    MappedMatrix &operator=(const MappedMatrix &) = delete;
+
+    /// Returns the number of rows (and columns).
+    std::size_t size() const { return n; }
+
+    /// Returns the value type of the entries.
+    MatrixValueType valueType() const { return type; }
+
+    /// Returns whether the file is flagged as symmetric.
+    bool isSymmetric() const { return symmetric; }
+
+    /// Returns the entries, row-major, when stored as Float32; otherwise nullptr.
+    const float *float32Values() const { return floats; }
+
+    /// Returns the entries, row-major, when stored as Float64; otherwise nullptr.
+    const double *float64Values() const { return doubles; }
+
+    /**
+     * @brief Returns entry (from, to).
+     *
+     * Checks the value type on every call; loops over many entries should pick
+     * float32Values() or float64Values() once instead.
+     *
+     * @param from Row index.
+     * @param to Column index.
+     * @return The entry as a double.
+     */
+    double at(int from, int to) const
+    {
+        std::size_t index = static_cast<std::size_t>(from) * n + static_cast<std::size_t>(to);
+        return type == MatrixValueType::Float32 ? static_cast<double>(floats[index]) : doubles[index];
+    }
+
+    /**
+     * @brief Writes a matrix file in the layout read by the constructor.
+     *
+     * @param path Path of the file.
+     * @param n Number of rows (and columns).
+     * @param values The n * n entries, row-major.
+     * @param type Value type to store.
+     * @param symmetric Whether to flag the matrix as symmetric.
+     * @throws std::runtime_error If the file cannot be written.
+     * @throws std::invalid_argument If values does not hold n * n entries.
+     */
+    static void write(const std::string &path, std::size_t n, const std::vector<double> &values,
+                      MatrixValueType type = MatrixValueType::Float32, bool symmetric = false);
+
+private:
+    std::size_t n = 0;                          ///< Number of rows (and columns).
+    MatrixValueType type = MatrixValueType::Float32; ///< Value type of the entries.
+    bool symmetric = false;                     ///< Symmetric flag of the file.
+    void *mapping = nullptr;                    ///< Start of the mapping.
+    std::size_t mappedSize = 0;                 ///< Size of the mapping.
+    const float *floats = nullptr;              ///< Entries, when stored as Float32.
+    const double *doubles = nullptr;            ///< Entries, when stored as Float64.
+};
+
+#endif // MAPPED_MATRIX_HPP
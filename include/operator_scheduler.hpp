@@ -0,0 +1,132 @@
+#ifndef OPERATOR_SCHEDULER_HPP
+#define OPERATOR_SCHEDULER_HPP
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+
+/**
+ * @brief Operators applied by GeneticAlgorithm::reproduce().
+ */
+enum class Operator
+{
+    Crossover,    ///< PMX crossover of two parents.
+    SwapMutation, ///< Swap of two customers inside a route.
+    RuinRecreate, ///< Ruin-and-recreate large neighborhood step.
+    TwoOpt,       ///< 2-opt on a single offspring route.
+    EliteTwoOpt,  ///< 2-opt on all routes of an elite solution.
+    Count
+};
+
+/**
+ * @brief Throughput statistics collected for one operator.
+ */
+struct OperatorStats
+{
+    const char *name = "";        ///< Human-readable operator name.
+    long long calls = 0;          ///< Number of times the operator was applied.
+    double totalMs = 0.0;         ///< Total time spent in the operator, in milliseconds.
+    double totalImprovement = 0.0; ///< Total cost reduction achieved by the operator.
+    double weight = 1.0;          ///< Current adaptive weight.
+    double rate = 0.0;            ///< Current application probability.
+
+    /// Returns the average cost reduction per millisecond of CPU time.
+    double improvementPerMs() const { return totalMs > 0.0 ? totalImprovement / totalMs : 0.0; }
+};
+
+/**
+ * @brief Adaptive operator scheduler (ALNS-style weight update).
+ *
+ * Keeps an application probability for every operator. In fixed mode the
+ * probabilities stay at their base values. In adaptive mode, at the end of every
+ * segment (one generation) each operator's weight is moved towards its
+ * improvement per millisecond in that segment, normalized by the best operator,
+ * and the probabilities are rescaled by weight / average weight. Operators that
+ * lower the cost cheaply get applied more often, expensive ones that do not
+ * pay off get applied less, but never below a minimum rate.
+ */
+class OperatorScheduler
+{
+public:
+    static constexpr std::size_t NumOperators = static_cast<std::size_t>(Operator::Count);
+
+    /// Constructs the scheduler with the default base rates.
+    OperatorScheduler();
+
+    /**
+     * @brief Enables or disables the adaptive weight update.
+     *
+     * Disabling the update resets all rates to their base values.
+     *
+     * @param enabled Whether rates are adapted.
+     */
+    void setAdaptive(bool enabled);
+
+    /// Returns whether the adaptive weight update is enabled.
+    bool isAdaptive() const { return adaptive; }
+
+    /**
+     * @brief Overrides the base application probability of an operator.
+     *
+     * @param op The operator.
+     * @param rate Base probability in [0, 1].
+     */
+    void setBaseRate(Operator op, double rate);
+
+    /**
+     * @brief Returns the current application probability of an operator.
+     *
+     * @param op The operator.
+     * @return The probability.
+     */
+    double rate(Operator op) const { return stats[index(op)].rate; }
+
+    /**
+     * @brief Records one application of an operator.
+     *
+     * @param op The operator that was applied.
+     * @param improvement Cost before minus cost after (negative values count as zero).
+     * @param elapsedMs Time spent in the operator, in milliseconds.
+     */
+    void record(Operator op, double improvement, double elapsedMs);
+
+    /**
+     * @brief Closes the current segment and updates weights and rates.
+     *
+     * Does nothing to the rates when the scheduler is not adaptive.
+     */
+    void endSegment();
+
+    /// Returns the cumulative statistics of all operators.
+    const std::array<OperatorStats, NumOperators> &getStats() const { return stats; }
+
+    /**
+     * @brief Writes the statistics as CSV (header line included).
+     *
+     * @param out Output stream.
+     */
+    void writeCsv(std::ostream &out) const { writeCsv(out, stats); }
+
+    /**
+     * @brief Writes a copy of the statistics as CSV (header line included).
+     *
+     * @param out Output stream.
+     * @param stats Statistics as returned by getStats().
+     */
+    static void writeCsv(std::ostream &out, const std::array<OperatorStats, NumOperators> &stats);
+
+private:
+    static std::size_t index(Operator op) { return static_cast<std::size_t>(op); }
+
+    std::array<OperatorStats, NumOperators> stats; ///< Cumulative statistics.
+    std::array<double, NumOperators> baseRates;    ///< Rates used in fixed mode.
+    std::array<double, NumOperators> segmentMs{};  ///< Time spent in the current segment.
+    std::array<double, NumOperators> segmentImprovement{}; ///< Improvement in the current segment.
+    bool adaptive = false;     ///< Whether the weight update is enabled.
+    double reaction = 0.2;     ///< Weight of the latest segment in the update.
+    double minWeight = 0.05;   ///< Lower bound for any weight, keeps every operator sampled.
+    double minRate = 0.02;     ///< Lower bound for any adapted rate.
+    double maxRate = 0.95;     ///< Upper bound for any adapted rate.
+};
+
+#endif // OPERATOR_SCHEDULER_HPP
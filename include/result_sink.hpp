@@ -0,0 +1,347 @@
+#ifndef RESULT_SINK_HPP
+#define RESULT_SINK_HPP
+
+#include "vrp.hpp"
+#include "operator_scheduler.hpp"
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Result of a single solver run.
+ */
+struct RunResult
+{
+    int run = 0;                           ///< Run number, starting at 1.
+    double cost = 0.0;                     ///< Cost of the best solution of the run.
+    std::vector<std::vector<int>> routes;  ///< Best solution of the run.
+    std::array<OperatorStats, OperatorScheduler::NumOperators> operators{}; ///< Operator statistics of the run.
+};
+
+/**
+ * @brief Aggregated results of a batch of runs.
+ */
+struct RunSummary
+{
+    int runs = 0;                          ///< Number of runs.
+    double averageCost = 0.0;              ///< Average best cost over all runs.
+    double bestCost = 0.0;                 ///< Best cost over all runs.
+    std::vector<std::vector<int>> routes;  ///< Best solution over all runs.
+};
+
+/**
+ * @brief Destination for solver results.
+ *
+ * Sinks receive one writeRun() call per run and a final writeSummary() call.
+ * Implementations buffer their output and only touch the stream on flush()
+ * or when their buffer is full.
+ */
+class ResultSink
+{
+public:
+    virtual ~ResultSink() = default;
+
+    /**
+     * @brief Writes the result of one run.
+     *
+     * @param result The run result.
+     */
+    virtual void writeRun(const RunResult &result) = 0;
+
+    /**
+     * @brief Writes the aggregated results of all runs.
+     *
+     * @param summary The summary.
+     */
+    virtual void writeSummary(const RunSummary &summary) = 0;
+
+    /// Pushes any buffered output to the underlying stream.
+    virtual void flush() {}
+};
+
+/**
+ * @brief Output buffer in front of a stream or a file.
+ *
+ * Collects writes in memory and hands them to the stream in large blocks.
+ */
+class BufferedOutput
+{
+public:
+    /**
+     * @brief Buffers writes to an existing stream.
+     *
+     * @param out The stream, which must outlive the buffer.
+     * @param capacity Buffer size in bytes that triggers a flush.
+     */
+    explicit BufferedOutput(std::ostream &out, std::size_t capacity = 1 << 16);
+
+    /**
+     * @brief Buffers writes to a file opened (and truncated) by the buffer.
+     *
+     * @param filename Path to the file.
+     * @param binary Whether the file is opened in binary mode.
+     * @param capacity Buffer size in bytes that triggers a flush.
+     */
+    BufferedOutput(const std::string &filename, bool binary, std::size_t capacity = 1 << 16);
+
+    /// Flushes the remaining buffer.
+    ~BufferedOutput();
+
+    BufferedOutput(const BufferedOutput &) = delete;
+    BufferedOutput &operator=(const BufferedOutput &) = delete;
+
+    /// Returns whether the underlying stream is usable (false after a failed write).
+    bool good() const { return out != nullptr && out->good(); }
+
+    /// Appends raw bytes.
+    void write(const std::string &data);
+
+    /// Appends a number formatted like std::ostream does by default (%g).
+    void writeNumber(double value);
+
+    /// Appends a number with full round-trip precision (%.17g).
+    void writeExactNumber(double value);
+
+    /// Appends an integer.
+    void writeInt(long long value);
+
+    /// Appends a single character.
+    void put(char c);
+
+    /// Hands the buffer to the stream and flushes the stream.
+    void flush();
+
+private:
+    void flushIfFull();
+
+    /// Hands the buffer to the stream; reports a failed write once and stops writing.
+    void writeBuffer();
+
+    std::string name;     ///< File name, or empty for a stream given by the caller.
+    std::ofstream file;   ///< Owned file, if any.
+    std::ostream *out;    ///< Stream receiving the data.
+    std::string buffer;   ///< Pending bytes.
+    std::size_t capacity; ///< Size that triggers a flush.
+};
+
+/**
+ * @brief Human-readable console writer.
+ *
+ * Prints one line per run and the summary with the routes of the best solution.
+ */
+class TextResultSink : public ResultSink
+{
+public:
+    /**
+     * @param out Stream to write to (e.g. std::cout).
+     * @param printRoutes Whether to also print the routes of every run.
+     */
+    explicit TextResultSink(std::ostream &out, bool printRoutes = false);
+    void writeRun(const RunResult &result) override;
+    void writeSummary(const RunSummary &summary) override;
+    void flush() override;
+
+private:
+    void writeRoutes(const std::vector<std::vector<int>> &routes);
+
+    BufferedOutput output; ///< Buffered stream.
+    bool printRoutes;      ///< Whether per-run routes are printed.
+};
+
+/**
+ * @brief Quiet console writer: prints only the final best cost.
+ */
+class QuietResultSink : public ResultSink
+{
+public:
+    explicit QuietResultSink(std::ostream &out);
+    void writeRun(const RunResult &) override {}
+    void writeSummary(const RunSummary &summary) override;
+    void flush() override;
+
+private:
+    BufferedOutput output; ///< Buffered stream.
+};
+
+/**
+ * @brief Writes the operator statistics of every run to run_<n>_operators.csv files.
+ *
+ * One row per operator with its calls, time, improvement, improvement per
+ * millisecond, adaptive weight and final application rate.
+ */
+class OperatorStatsSink : public ResultSink
+{
+public:
+    /// @param directory Directory receiving the files.
+    explicit OperatorStatsSink(const std::string &directory);
+    void writeRun(const RunResult &result) override;
+    void writeSummary(const RunSummary &) override {}
+
+private:
+    std::string directory; ///< Output directory.
+};
+
+/**
+ * @brief Writes the run/cost CSV table with the average and best rows.
+ */
+class CsvResultSink : public ResultSink
+{
+public:
+    explicit CsvResultSink(const std::string &filename);
+    void writeRun(const RunResult &result) override;
+    void writeSummary(const RunSummary &summary) override;
+    void flush() override;
+
+private:
+    BufferedOutput output; ///< Buffered file.
+};
+
+/**
+ * @brief Writes the routes of every run to output/run_<n>_routes.txt style files.
+ */
+class RouteFilesSink : public ResultSink
+{
+public:
+    /// @param directory Directory receiving the files.
+    explicit RouteFilesSink(const std::string &directory);
+    void writeRun(const RunResult &result) override;
+    void writeSummary(const RunSummary &) override {}
+
+private:
+    std::string directory; ///< Output directory.
+};
+
+/**
+ * @brief Writes one JSON object per line: one per run, then the summary.
+ */
+class JsonLinesResultSink : public ResultSink
+{
+public:
+    explicit JsonLinesResultSink(const std::string &filename);
+    void writeRun(const RunResult &result) override;
+    void writeSummary(const RunSummary &summary) override;
+    void flush() override;
+
+private:
+    void writeRoutes(const std::vector<std::vector<int>> &routes);
+
+    BufferedOutput output; ///< Buffered file.
+};
+
+/**
+ * @brief Writes runs in the compact binary solution format.
+ *
+ * The file starts with the magic bytes "VRPS" and a version byte, followed by
+ * one record per run: the run number as a varint and the solution encoded
+ * with encodeSolution().
+ */
+class BinaryResultSink : public ResultSink
+{
+public:
+    explicit BinaryResultSink(const std::string &filename);
+    void writeRun(const RunResult &result) override;
+    void writeSummary(const RunSummary &) override {}
+    void flush() override;
+
+private:
+    BufferedOutput output; ///< Buffered file.
+    std::string record;    ///< Reused encoding buffer.
+};
+
+/**
+ * @brief Writes solutions in the Solomon .sol layout (as in data/C101.sol).
+ *
+ * Every run goes to run_<n>.sol and the best solution to best.sol. Only
+ * non-empty routes are written, numbered from 1, using the customer numbers
+ * from the instance file, followed by the cost rounded to one decimal.
+ */
+class SolomonResultSink : public ResultSink
+{
+public:
+    /**
+     * @param directory Directory receiving the files.
+     * @param vrp Instance used to map node indices to customer numbers.
+     */
+    SolomonResultSink(const std::string &directory, const VRP &vrp);
+    void writeRun(const RunResult &result) override;
+    void writeSummary(const RunSummary &summary) override;
+
+private:
+    void writeSolution(const std::string &filename, const std::vector<std::vector<int>> &routes, double cost) const;
+
+    std::string directory; ///< Output directory.
+    const VRP &vrp;        ///< Instance of the solutions.
+};
+
+/**
+ * @brief Forwards every call to several sinks.
+ */
+class MultiResultSink : public ResultSink
+{
+public:
+    /// Adds a sink; the multi sink takes ownership.
+    void add(std::unique_ptr<ResultSink> sink);
+    void writeRun(const RunResult &result) override;
+    void writeSummary(const RunSummary &summary) override;
+    void flush() override;
+
+private:
+    std::vector<std::unique_ptr<ResultSink>> sinks; ///< Target sinks.
+};
+
+/**
+ * @brief Runs another sink on a background thread.
+ *
+ * Calls are queued and return immediately; the worker thread forwards them to
+ * the wrapped sink in order. flush() waits until the queue is drained and the
+ * wrapped sink is flushed. The destructor drains the queue and joins the thread.
+ */
+class AsyncResultSink : public ResultSink
+{
+public:
+    explicit AsyncResultSink(std::unique_ptr<ResultSink> sink);
+    ~AsyncResultSink() override;
+
+    AsyncResultSink(const AsyncResultSink &) = delete;
+    AsyncResultSink &operator=(const AsyncResultSink &) = delete;
+
+    void writeRun(const RunResult &result) override;
+    void writeSummary(const RunSummary &summary) override;
+    void flush() override;
+
+private:
+    /// Queued call.
+    struct Task
+    {
+        enum class Kind
+        {
+            Run,
+            Summary,
+            Flush
+        } kind;
+        RunResult run;
+        RunSummary summary;
+    };
+
+    void push(Task task);
+    void worker();
+
+    std::unique_ptr<ResultSink> sink; ///< Wrapped sink, only used by the worker.
+    std::deque<Task> queue;           ///< Pending calls.
+    std::mutex mutex;                 ///< Guards queue, stopping and pending.
+    std::condition_variable wake;     ///< Signals new tasks to the worker.
+    std::condition_variable drained;  ///< Signals an empty queue to flush().
+    std::size_t pending = 0;          ///< Tasks queued or being processed.
+    bool stopping = false;            ///< Set by the destructor.
+    std::thread thread;               ///< Worker thread.
+};
+
+#endif // RESULT_SINK_HPP
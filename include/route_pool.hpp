@@ -0,0 +1,111 @@
+#ifndef ROUTE_POOL_HPP
+#define ROUTE_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Deduplicated pool of routes gathered from evaluated solutions.
+ *
+ * Routes are keyed by their customer set (a Zobrist hash: the XOR of a random
+ * 64-bit key per customer, so the key does not depend on the visiting order),
+ * and only the cheapest known route per set is kept. assemble() recombines
+ * pool routes into a new solution with a set-partitioning heuristic.
+ *
+ * The pool refers to node indices, so it must be cleared when the instance
+ * changes; it records the VRP::getRevision() it was reset for. It is not
+ * thread-safe.
+ */
+class RoutePool
+{
+public:
+    /**
+     * @brief Route of the pool with its cost.
+     */
+    struct Entry
+    {
+        std::vector<int> route;  ///< Customers in visiting order.
+        double cost = 0.0;       ///< Cost of the route (distance plus penalties).
+        std::uint64_t hash = 0;  ///< Zobrist hash of the customer set.
+        std::uint64_t check = 0; ///< Second, independent hash, to detect collisions.
+    };
+
+    /**
+     * @brief Constructs an empty pool.
+     *
+     * @param numNodes Number of nodes including the depot.
+     * @param capacity Routes kept; beyond it the routes with the highest cost per customer are evicted.
+     */
+    explicit RoutePool(std::size_t numNodes = 0, std::size_t capacity = 5000);
+
+    /**
+     * @brief Removes all routes and sets the instance.
+     *
+     * @param numNodes Number of nodes including the depot.
+     * @param instanceRevision VRP::getRevision() of the instance.
+     */
+    void reset(std::size_t numNodes, std::uint64_t instanceRevision = 0);
+
+    /**
+     * @brief Adds a route, or improves the route of its customer set.
+     *
+     * @param route Customers in visiting order; empty routes are ignored.
+     * @param cost Cost of the route.
+     * @return True if the pool changed.
+     */
+    bool add(const std::vector<int> &route, double cost);
+
+    /**
+     * @brief Returns whether the pool already holds a route with exactly this sequence.
+     *
+     * Lets callers skip evaluating routes that are known.
+     *
+     * @param route Customers in visiting order.
+     * @return True if the same route is stored.
+     */
+    bool containsRoute(const std::vector<int> &route) const;
+
+    /**
+     * @brief Recombines pool routes into a solution (set partitioning).
+     *
+     * Greedily picks disjoint routes by cost per customer, then improves the
+     * selection with swap-in moves: a pool route enters and the selected
+     * routes it overlaps leave whenever that lowers the cost, counting every
+     * uncovered customer at uncoveredPenalty. Customers that stay uncovered are
+     * missing from the result and must be inserted by the caller.
+     *
+     * @param maxRoutes Maximum number of routes (vehicles).
+     * @param uncoveredPenalty Estimated cost of serving an uncovered customer.
+     * @param routes Receives the selected routes.
+     * @return The pool cost of the selected routes.
+     */
+    double assemble(std::size_t maxRoutes, double uncoveredPenalty, std::vector<std::vector<int>> &routes) const;
+
+    /// Returns the number of nodes the pool was set up for.
+    std::size_t getNumNodes() const { return numNodes; }
+
+    /// Returns the instance revision the pool was set up for.
+    std::uint64_t getInstanceRevision() const { return instanceRevision; }
+
+    /// Returns the number of routes in the pool.
+    std::size_t size() const { return entries.size(); }
+
+    /// Returns the routes of the pool.
+    const std::vector<Entry> &getEntries() const { return entries; }
+
+private:
+    /// Evicts the routes with the highest cost per customer down to the capacity.
+    void prune();
+
+    std::size_t numNodes;                            ///< Number of nodes including the depot.
+    std::size_t capacity;                            ///< Routes kept after pruning.
+    std::uint64_t instanceRevision = 0;              ///< Revision of the instance.
+    std::vector<std::uint64_t> keys;                 ///< Zobrist key per node.
+    std::vector<std::uint64_t> checkKeys;            ///< Keys of the collision check hash.
+    std::vector<Entry> entries;                      ///< Routes of the pool.
+    std::unordered_map<std::uint64_t, std::size_t> index; ///< Hash -> entry.
+};
+
+#endif // ROUTE_POOL_HPP
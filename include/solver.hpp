@@ -0,0 +1,145 @@
+#ifndef SOLVER_HPP
+#define SOLVER_HPP
+
+#include "vrp.hpp"
+#include "genetic_algorithm.hpp"
+#include "evaluation.hpp"
+#include "operator_scheduler.hpp"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Configuration of a single solve() call.
+ */
+struct SolverConfig
+{
+    int populationSize = 50;                                   ///< Number of individuals.
+    int generations = 100;                                     ///< Maximum number of generations.
+    double timeLimitSeconds = 0.0;                             ///< Wall-clock limit, 0 for none.
+    SelectionMethod selectionMethod = SelectionMethod::Tournament; ///< Parent selection method.
+    int tournamentSize = 3;                                    ///< Tournament size.
+    MutationMethod mutationMethod = MutationMethod::RuinRecreate;  ///< Mutation operator.
+    int ruinRemovalSize = 15;                                  ///< Customers removed per ruin-and-recreate step.
+    bool adaptiveOperators = true;                             ///< Whether operator rates are adapted.
+    SurvivorSelection survivorSelection = SurvivorSelection::BiasedFitness; ///< Survivor selection method.
+    DistanceType distanceType = DistanceType::Double;          ///< Distance representation.
+    ConstraintType constraintType = ConstraintType::Unconstrained; ///< Enforced constraints.
+    ConstraintPenalties penalties;                             ///< Penalty weights for constraint violations.
+    bool routePool = false;                                    ///< Whether route-pool recombination is used (costs run time).
+    int setPartitioningInterval = 20;                          ///< Generations between two recombinations.
+    std::shared_ptr<RoutePool> sharedRoutePool;                ///< Pool shared by several runs (sequentially), nullptr for one per run.
+    unsigned int seed = 0;                                     ///< Random seed, 0 to seed from the clock (reproducible only without adaptive operators, whose rates depend on timings).
+};
+
+/**
+ * @brief Cooperative cancellation flag for solve().
+ *
+ * May be cancelled from any thread; the solver checks it between generations
+ * and returns the best solution found so far.
+ */
+class CancellationToken
+{
+public:
+    /// Requests cancellation.
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+
+    /// Returns whether cancellation was requested.
+    bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+    /// Clears the flag so the token can be reused.
+    void reset() { cancelled.store(false, std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> cancelled{false}; ///< Cancellation flag.
+};
+
+/**
+ * @brief Statistics of a solve() call.
+ */
+struct SolveStatistics
+{
+    int generations = 0;                ///< Generations actually run.
+    double elapsedMs = 0.0;             ///< Wall-clock time, in milliseconds.
+    double initialCost = 0.0;           ///< Best cost of the initial population.
+    bool cancelled = false;             ///< Whether the run was stopped by the token.
+    bool timedOut = false;              ///< Whether the run was stopped by the time limit.
+    std::vector<double> bestCostHistory; ///< Best cost after every generation.
+    std::size_t routePoolSize = 0;      ///< Routes in the route pool at the end.
+    int setPartitioningImprovements = 0; ///< Recombinations that improved the best solution.
+    std::array<OperatorStats, OperatorScheduler::NumOperators> operators; ///< Per-operator statistics.
+};
+
+/**
+ * @brief Result of a solve() call.
+ */
+struct SolveResult
+{
+    std::vector<std::vector<int>> routes; ///< Best solution found (node indices, depot omitted).
+    double cost = 0.0;                    ///< Cost of the best solution.
+    SolveStatistics statistics;           ///< Run statistics.
+    std::vector<std::vector<std::vector<int>>> population; ///< Final population, to warm-start a later solve.
+};
+
+/**
+ * @brief Applies a configuration to a GeneticAlgorithm, except the population.
+ *
+ * Shared by solve() and the island runners so they configure the algorithm
+ * the same way.
+ *
+ * @param ga The algorithm to configure.
+ * @param config Solver configuration.
+ */
+void configureSolver(GeneticAlgorithm &ga, const SolverConfig &config);
+
+/**
+ * @brief Solves an instance that is already in memory.
+ *
+ * Reentrant: every call owns its own GeneticAlgorithm, and the instance is only
+ * read, so several calls may run concurrently on the same VRP (but not on the
+ * same config.sharedRoutePool).
+ *
+ * @param vrp The instance.
+ * @param config Solver configuration.
+ * @param token Optional cancellation token.
+ * @return The best solution with statistics.
+ * @throws std::invalid_argument If the instance has no customers or no vehicles.
+ */
+SolveResult solve(const VRP &vrp, const SolverConfig &config = SolverConfig(), const CancellationToken *token = nullptr);
+
+/**
+ * @brief Re-solves an instance starting from previous solutions (warm start).
+ *
+ * For dispatch loops that re-solve a slowly changing instance: apply the
+ * changes with VRP::applyDelta(), translate the previous SolveResult::population
+ * (or just its best routes) with VRP::remapRoutes() and pass it here. The seeds
+ * are repaired and completed as in GeneticAlgorithm::initializePopulation(),
+ * so far fewer generations are needed than from a random population.
+ *
+ * @param vrp The instance.
+ * @param seeds Previous solutions in the current node indices; empty for a cold start.
+ * @param config Solver configuration.
+ * @param token Optional cancellation token.
+ * @return The best solution with statistics.
+ * @throws std::invalid_argument If the instance has no customers or no vehicles.
+ */
+SolveResult solve(const VRP &vrp, const std::vector<std::vector<std::vector<int>>> &seeds,
+                  const SolverConfig &config = SolverConfig(), const CancellationToken *token = nullptr);
+
+/**
+ * @brief Builds an instance from memory and solves it.
+ *
+ * @param nodes Depot (index 0) followed by the customers.
+ * @param numVehicles Number of vehicles.
+ * @param vehicleCapacity Capacity of a single vehicle (0 for unlimited).
+ * @param config Solver configuration.
+ * @param token Optional cancellation token.
+ * @return The best solution with statistics.
+ * @throws std::invalid_argument If the instance has no customers or no vehicles.
+ */
+SolveResult solve(std::vector<Node> nodes, int numVehicles, int vehicleCapacity,
+                  const SolverConfig &config = SolverConfig(), const CancellationToken *token = nullptr);
+
+#endif // SOLVER_HPP
@@ -0,0 +1,52 @@
+#ifndef UTILS_HPP
+#define UTILS_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Appends an unsigned integer in LEB128 variable-length encoding.
+ *
+ * Values below 128 take a single byte, which keeps customer indices compact.
+ *
+ * @param out Buffer the bytes are appended to.
+ * @param value Value to encode.
+ */
+void appendVarint(std::string &out, std::uint64_t value);
+
+/**
+ * @brief Reads an unsigned integer written by appendVarint().
+ *
+ * @param pos Read position, advanced past the value on success.
+ * @param end End of the readable buffer.
+ * @param value Decoded value.
+ * @return True on success, false if the buffer ended or the value is malformed.
+ */
+bool readVarint(const char *&pos, const char *end, std::uint64_t &value);
+
+/**
+ * @brief Appends a solution in the compact binary solution format.
+ *
+ * Layout: cost as 8 raw bytes (IEEE-754 double, host byte order), the number of
+ * routes as a varint, then for every route its length followed by its node
+ * indices, all as varints. Empty routes are kept so vehicle slots round-trip.
+ *
+ * @param out Buffer the encoded solution is appended to.
+ * @param routes The solution.
+ * @param cost The cost of the solution.
+ */
+void encodeSolution(std::string &out, const std::vector<std::vector<int>> &routes, double cost);
+
+/**
+ * @brief Decodes a solution written by encodeSolution().
+ *
+ * @param pos Read position, advanced past the solution on success.
+ * @param end End of the readable buffer.
+ * @param routes Decoded solution.
+ * @param cost Decoded cost.
+ * @return True on success, false if the buffer is truncated or malformed.
+ */
+bool decodeSolution(const char *&pos, const char *end, std::vector<std::vector<int>> &routes, double &cost);
+
+#endif // UTILS_HPP
@@ -1,6 +1,12 @@
 #ifndef VRP_HPP
 #define VRP_HPP
 
+#include "mapped_matrix.hpp"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
 #include <vector>
 #include <string>
 
@@ -13,6 +19,22 @@ struct Node
     double x;   ///< X coordinate
     double y;   ///< Y coordinate
     int demand; ///< Demand at the node (0 for depot)
+    double readyTime = 0.0;                                   ///< Earliest service start
+    double dueDate = std::numeric_limits<double>::max();      ///< Latest service start
+    double serviceTime = 0.0;                                 ///< Duration of the service
+};
+
+/**
+ * @brief Changes between two versions of an instance, for incremental re-optimization.
+ *
+ * Indices refer to the instance the delta is applied to. The depot (index 0)
+ * may be moved but not removed.
+ */
+struct InstanceDelta
+{
+    std::vector<int> removed;                 ///< Indices of the customers to remove.
+    std::vector<Node> added;                  ///< New customers, appended after the remaining ones.
+    std::vector<std::pair<int, Node>> moved;  ///< Index and new data of the nodes that changed (location, demand, time window).
 };
 
 /**
@@ -36,13 +58,131 @@ public:
      * The file is expected to contain a header section (with VEHICLE information)
      * followed by a CUSTOMER section. The parser skips all lines until the line containing
      * "CUSTOMER" is encountered, then skips the header line (which contains "CUST NO") and
-     * finally processes each customer line. Only the first four fields (customer number, X coordinate,
-     * Y coordinate, demand) are parsed; other columns are ignored.
+     * finally processes each customer line. The customer number, X coordinate, Y coordinate and
+     * demand are required; the ready time, due date and service time columns are read when present.
      *
      * @param filename Path to the data file.
      */
     void loadData(const std::string &filename);
 
+    /**
+     * @brief Sets the instance data directly from memory.
+     *
+     * The node with index 0 is the depot. Rebuilds the distance caches and the
+     * neighbor lists, like loadData(); external matrices are dropped.
+     *
+     * @param newNodes Depot followed by the customers.
+     * @param vehicles Number of vehicles.
+     * @param capacity Capacity of a single vehicle (0 for unlimited).
+     * @param numNeighbors Maximum number of neighbors kept per node.
+     */
+    void setData(std::vector<Node> newNodes, int vehicles, int capacity, int numNeighbors = 40);
+
+    /**
+     * @brief Uses an external distance matrix instead of Euclidean distances.
+     *
+     * The matrix file (see MappedMatrix) is memory-mapped, not copied: dist()
+     * reads it directly and no dense matrix is built. It may be asymmetric;
+     * entry (i, j) is the cost from node i to node j, indexed like the nodes.
+     * The neighbor lists are rebuilt from the matrix rows, an O(n^2) scan;
+     * an asymmetric matrix also gets incoming lists (getIncomingNeighbors()).
+     * The node coordinates are no longer used for distances.
+     *
+     * @param path Path of the matrix file.
+     * @throws std::runtime_error If the file cannot be mapped.
+     * @throws std::invalid_argument If its size differs from the number of nodes.
+     */
+    void loadDistanceMatrix(const std::string &path);
+
+    /**
+     * @brief Uses an external travel-time matrix for the time windows.
+     *
+     * Memory-mapped like loadDistanceMatrix(). Without it, travel times equal
+     * the distances.
+     *
+     * @param path Path of the matrix file.
+     * @throws std::runtime_error If the file cannot be mapped.
+     * @throws std::invalid_argument If its size differs from the number of nodes.
+     */
+    void loadDurationMatrix(const std::string &path);
+
+    /// Returns whether an external distance matrix is loaded.
+    bool hasDistanceMatrix() const { return distanceFile != nullptr; }
+
+    /// Returns the external distance matrix, or nullptr.
+    const MappedMatrix *getDistanceFile() const { return distanceFile.get(); }
+
+    /// Returns the dense distance matrix, row-major (empty in large-instance mode or with an external matrix).
+    const std::vector<double> &getDistanceMatrix() const { return distanceMatrix; }
+
+    /// Returns whether a separate travel-time matrix is loaded.
+    bool hasDurationMatrix() const { return durationFile != nullptr; }
+
+    /// Returns the external travel-time matrix, or nullptr.
+    const MappedMatrix *getDurationFile() const { return durationFile.get(); }
+
+    /// Returns whether dist(i, j) == dist(j, i) is guaranteed (Euclidean, or a matrix flagged symmetric).
+    bool isSymmetric() const { return distanceFile == nullptr || distanceFile->isSymmetric(); }
+
+    /**
+     * @brief Applies an instance delta in place.
+     *
+     * Removed customers are swap-removed (the last node moves into the freed
+     * index), added customers are appended. Only the distance matrix rows and
+     * columns of moved and added nodes are recomputed; the rest is copied from
+     * the previous matrix. The neighbor lists are rebuilt.
+     *
+     * @param delta Changes to apply.
+     * @return Map from every previous node index to its new index, -1 for removed customers.
+     * @throws std::invalid_argument If an index is out of range or the depot is removed.
+     * @throws std::logic_error If external matrices are loaded; load the updated matrices instead.
+     */
+    std::vector<int> applyDelta(const InstanceDelta &delta);
+
+    /**
+     * @brief Translates a solution to the node indices after applyDelta().
+     *
+     * Removed customers are dropped; added customers are not inserted. When
+     * the delta is given, its moved customers are dropped as well, so that a
+     * warm start reinserts them next to their new location.
+     *
+     * @param routes Solution in the previous node indices.
+     * @param indexMap Map returned by applyDelta().
+     * @param delta The applied delta (optional).
+     * @return The solution in the new node indices.
+     */
+    static std::vector<std::vector<int>> remapRoutes(const std::vector<std::vector<int>> &routes, const std::vector<int> &indexMap,
+                                                     const InstanceDelta *delta = nullptr);
+
+    /**
+     * @brief Enables the large-instance mode.
+     *
+     * In large-instance mode no distance matrix is kept: distances are computed
+     * on the fly from the coordinate arrays, and the operators restrict their
+     * neighborhoods to the neighbor lists. Instances with more than
+     * DenseMatrixLimit nodes always use this mode. Takes effect on the next
+     * loadData(), setData() or buildCaches() call.
+     *
+     * @param enabled Whether the mode is forced on.
+     */
+    void setLargeInstanceMode(bool enabled) { forceLargeInstance = enabled; }
+
+    /// Returns whether the instance is handled in large-instance mode.
+    bool isLargeInstance() const { return largeInstance; }
+
+    /**
+     * @brief Returns the revision of the instance data.
+     *
+     * loadData(), setData(), buildCaches(), applyDelta() and loading a matrix
+     * assign a revision that no other VRP of the process had before, so caches
+     * keyed by node index (such as a RoutePool) can tell when they are stale.
+     * Copies keep the revision of their source.
+     */
+    std::uint64_t getRevision() const { return revision; }
+
+    /// Largest number of nodes for which a full distance matrix is built.
+    static constexpr std::size_t DenseMatrixLimit = 2000;
+
     /**
      * @brief Computes the Euclidean distance between two nodes.
      *
@@ -52,6 +192,91 @@ public:
      */
     double distance(const Node &a, const Node &b) const;
 
+    /**
+     * @brief Returns the cached distance between two nodes given by index.
+     *
+     * Reads from the distance matrix precomputed by loadData(), so it is much
+     * cheaper than distance() in inner loops of the operators. With an external
+     * matrix the mapped file is read; otherwise, in large-instance mode, the
+     * distance is computed from the coordinate arrays. The evaluation core
+     * resolves the source once instead (see makeEvaluationCore()).
+     *
+     * @param from Index of the first node.
+     * @param to Index of the second node.
+     * @return The distance between the two nodes.
+     */
+    double dist(int from, int to) const
+    {
+        if (!distanceMatrix.empty())
+            return distanceMatrix[static_cast<std::size_t>(from) * nodes.size() + to];
+        if (distanceFile)
+            return distanceFile->at(from, to);
+        double dx = xs[from] - xs[to];
+        double dy = ys[from] - ys[to];
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    /**
+     * @brief Returns the travel time between two nodes given by index.
+     *
+     * Reads the external travel-time matrix when one is loaded, otherwise
+     * equals dist().
+     *
+     * @param from Index of the first node.
+     * @param to Index of the second node.
+     * @return The travel time.
+     */
+    double travelTime(int from, int to) const
+    {
+        return durationFile ? durationFile->at(from, to) : dist(from, to);
+    }
+
+    /**
+     * @brief Returns the nearest customers of a node, closest first.
+     *
+     * The depot (index 0) is never part of a neighbor list.
+     *
+     * @param node Index of the node.
+     * @return A constant reference to the neighbor list.
+     */
+    const std::vector<int> &getNeighbors(int node) const { return neighbors[node]; }
+
+    /**
+     * @brief Returns the customers closest to a node in the incoming direction, closest first.
+     *
+     * Sorted by dist(customer, node). Equals getNeighbors() unless the
+     * external distance matrix is asymmetric.
+     *
+     * @param node Index of the node.
+     * @return A constant reference to the neighbor list.
+     */
+    const std::vector<int> &getIncomingNeighbors(int node) const
+    {
+        return incomingNeighbors.empty() ? neighbors[node] : incomingNeighbors[node];
+    }
+
+    /**
+     * @brief Returns the distances to the nearest customers of a node.
+     *
+     * Parallel to getNeighbors(); lets candidate-list loops skip the distance lookup.
+     *
+     * @param node Index of the node.
+     * @return A constant reference to the distances.
+     */
+    const std::vector<double> &getNeighborDistances(int node) const { return neighborDistances[node]; }
+
+    /**
+     * @brief Rebuilds the distance matrix and the neighbor lists.
+     *
+     * Called automatically by loadData(); only needs to be called again to
+     * change the neighbor list length. The neighbor lists are found with a
+     * uniform grid over the coordinates, so this is near-linear in the number
+     * of nodes.
+     *
+     * @param numNeighbors Maximum number of neighbors kept per node.
+     */
+    void buildCaches(int numNeighbors = 40);
+
     /**
      * @brief Computes the total cost of a given route.
      *
@@ -69,9 +294,33 @@ public:
      */
     const std::vector<Node> &getNodes() const;
     int getNumVehicles() const { return numVehicles; }
+    int getVehicleCapacity() const { return vehicleCapacity; }
 private:
-    std::vector<Node> nodes; ///< List of nodes.
-    int numVehicles = 0;     ///< Number of vehicles.
+    /// Rebuilds the neighbor lists of all nodes with the grid search.
+    void buildNeighborLists();
+
+    /// Rebuilds the neighbor lists by scanning the rows of the external distance matrix,
+    /// and the incoming lists too when it is asymmetric.
+    void buildNeighborListsFromMatrix(std::size_t k);
+
+    /// Maps a matrix file and checks that it matches the instance size.
+    std::shared_ptr<const MappedMatrix> mapMatrix(const std::string &path) const;
+
+    std::vector<Node> nodes;               ///< List of nodes.
+    int numVehicles = 0;                   ///< Number of vehicles.
+    int vehicleCapacity = 0;               ///< Capacity of a single vehicle.
+    std::vector<double> xs;                ///< X coordinates of the nodes (by index).
+    std::vector<double> ys;                ///< Y coordinates of the nodes (by index).
+    std::vector<double> distanceMatrix;    ///< Row-major matrix of distances between nodes (empty in large-instance mode).
+    std::vector<std::vector<int>> neighbors; ///< Nearest customers of every node.
+    std::vector<std::vector<double>> neighborDistances; ///< Distances to the nearest customers.
+    std::vector<std::vector<int>> incomingNeighbors; ///< Nearest customers towards every node (asymmetric matrices only).
+    std::shared_ptr<const MappedMatrix> distanceFile; ///< External distance matrix, if loaded.
+    std::shared_ptr<const MappedMatrix> durationFile; ///< External travel-time matrix, if loaded.
+    int neighborListSize = 40;             ///< Maximum number of neighbors kept per node.
+    bool forceLargeInstance = false;       ///< Large-instance mode requested by the user.
+    bool largeInstance = false;            ///< Whether the current instance uses large-instance mode.
+    std::uint64_t revision = 0;            ///< Revision of the instance data, see getRevision().
 };
 
 #endif // VRP_HPP
@@ -0,0 +1,2 @@
+Route #1: 3 7 5 75 1 2 4 6 9 8 10 11 12 14 16 15 19 18 17 13 30 28 26 23 22 21 20 24 25 27 29 34 36 39 38 37 35 33 32 31 52 49 47 43 41 40 42 44 46 45 48 50 51 59 60 58 56 53 54 57 55 68 64 61 72 66 69 67 65 63 62 74 80 79 77 73 70 71 76 78 81 82 83 84 85 88 89 86 87 90 91 98 99 100 96 95 94 92 93 97 
+Cost 536.7
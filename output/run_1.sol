@@ -0,0 +1,2 @@
+Route #1: 5 75 91 89 90 87 86 83 81 80 79 77 73 70 71 76 78 82 84 85 88 98 96 95 94 92 93 97 100 99 2 1 4 3 7 6 8 9 11 10 13 12 14 16 15 19 18 17 30 28 26 23 21 20 22 25 27 29 24 52 49 47 43 67 65 63 62 74 72 61 64 66 69 68 55 54 53 56 58 60 59 57 40 41 42 44 45 46 48 50 51 31 32 33 34 36 39 38 37 35 
+Cost 571.4
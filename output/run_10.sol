@@ -0,0 +1,2 @@
+Route #1: 10 7 3 5 75 90 87 86 80 79 77 73 70 71 76 78 81 82 83 84 85 88 89 91 98 96 95 94 92 93 97 100 99 2 1 4 6 8 9 11 12 14 16 15 13 17 19 18 30 28 26 23 21 20 67 65 63 66 69 68 64 61 62 74 72 55 57 59 54 53 56 58 60 44 40 41 42 43 47 49 52 46 45 48 50 51 31 35 37 38 39 36 34 33 32 29 27 25 24 22 
+Cost 556.9
@@ -0,0 +1,2 @@
+Route #1: 2 1 75 5 3 7 4 6 8 9 12 14 16 15 19 18 17 13 11 10 21 20 22 23 26 28 30 25 24 27 29 34 36 39 38 37 35 31 33 32 52 49 50 51 48 46 47 43 41 40 42 44 45 59 57 60 58 56 53 54 55 68 64 61 72 74 62 66 69 67 65 63 80 79 77 73 70 71 76 78 81 82 83 84 85 88 96 95 94 92 93 97 100 99 98 91 89 86 87 90 
+Cost 543.2
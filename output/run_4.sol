@@ -0,0 +1,2 @@
+Route #1: 8 9 6 4 2 1 75 5 3 7 10 11 12 14 16 15 19 18 17 13 28 26 23 21 22 24 25 27 30 29 32 33 34 36 39 38 37 35 31 52 50 51 48 45 46 49 47 42 44 40 41 43 20 67 65 63 66 69 68 57 59 60 58 56 53 54 55 64 61 62 74 72 80 79 77 73 70 71 76 78 81 82 83 84 85 86 87 90 89 88 91 98 96 95 94 92 93 97 100 99 
+Cost 561.5
@@ -0,0 +1,2 @@
+Route #1: 32 33 34 36 39 38 37 35 31 52 49 47 50 51 48 45 46 44 40 59 57 55 54 60 58 56 53 72 74 61 64 68 69 66 62 63 65 67 41 42 43 20 21 22 24 29 30 28 27 25 26 23 13 17 18 19 15 16 14 12 9 11 10 8 6 7 5 3 4 2 1 75 91 90 89 87 86 80 79 77 73 70 71 76 78 81 82 83 84 85 88 98 96 95 94 92 93 97 100 99 
+Cost 579.8
@@ -0,0 +1,2 @@
+Route #1: 50 51 48 60 58 56 53 54 55 57 59 40 41 42 44 45 46 43 47 49 52 31 35 33 37 38 39 36 34 32 29 27 25 24 20 21 22 23 26 28 30 17 18 19 15 16 14 12 13 11 10 8 9 6 4 7 3 5 75 1 2 91 90 63 65 67 62 66 69 68 64 61 72 74 80 79 77 73 70 71 76 78 81 82 83 84 86 87 89 88 85 98 99 100 97 96 95 94 93 92 
+Cost 576.8
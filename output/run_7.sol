@@ -0,0 +1,2 @@
+Route #1: 22 21 20 24 49 47 43 41 40 42 44 46 45 48 51 50 52 32 31 35 33 37 38 39 36 34 29 27 25 23 26 28 30 13 17 18 19 16 14 12 15 11 10 8 9 6 4 2 1 3 7 5 75 91 90 63 65 67 62 74 72 61 64 66 69 68 57 59 60 58 56 53 54 55 80 79 77 73 70 71 76 78 81 82 83 86 87 89 88 84 85 98 96 99 100 97 93 92 94 95 
+Cost 580.0
@@ -0,0 +1,2 @@
+Route #1: 1 75 5 3 7 6 4 2 99 100 97 93 92 94 95 96 98 91 90 87 86 89 88 85 84 83 82 78 76 71 70 73 77 79 80 81 72 61 64 74 63 65 67 62 66 69 68 55 54 53 56 58 60 57 59 44 40 41 42 43 47 46 45 48 51 50 49 52 31 35 37 38 39 36 34 33 32 29 24 20 21 22 25 27 30 28 26 23 10 8 9 11 13 17 18 19 15 16 14 12 
+Cost 546.5
@@ -0,0 +1,2 @@
+Route #1: 2 6 9 11 12 14 16 15 19 18 17 13 26 28 30 34 36 39 38 37 33 35 31 32 52 50 51 48 45 60 58 56 53 54 55 57 59 68 64 61 72 81 80 79 77 73 70 71 76 78 82 83 84 85 88 86 87 89 91 90 67 65 63 74 62 66 69 41 40 44 42 43 46 47 49 29 27 25 24 20 21 22 23 10 8 7 4 3 5 75 1 98 95 94 92 93 97 96 99 100 
+Cost 599.6
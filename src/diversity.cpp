@@ -0,0 +1,155 @@
+#include "diversity.hpp"
+#include <algorithm>
+#include <numeric>
+
+PopulationDiversity::PopulationDiversity(std::size_t numNodes)
+    : numNodes(numNodes)
+{
+}
+
+void PopulationDiversity::reset(std::size_t nodes)
+{
+    numNodes = nodes;
+    slots.clear();
+}
+
+void PopulationDiversity::buildLinks(const std::vector<std::vector<int>> &routes, std::size_t numNodes, Links &links)
+{
+    links.successor.assign(numNodes, 0);
+    links.predecessor.assign(numNodes, 0);
+    for (const auto &route : routes)
+    {
+        int prev = 0;
+        for (int customer : route)
+        {
+            links.predecessor[customer] = prev;
+            if (prev != 0)
+                links.successor[prev] = customer;
+            prev = customer;
+        }
+        if (prev != 0)
+            links.successor[prev] = 0;
+    }
+}
+
+double PopulationDiversity::distance(const Links &a, const Links &b)
+{
+    std::size_t n = a.successor.size();
+    if (n < 2)
+        return 0.0;
+
+    // Branch-free so the loop vectorizes; all arrays are read at the same index.
+    const int *succA = a.successor.data();
+    const int *predA = a.predecessor.data();
+    const int *succB = b.successor.data();
+    const int *predB = b.predecessor.data();
+    int broken = 0;
+    for (std::size_t i = 1; i < n; ++i)
+    {
+        broken += (succA[i] != succB[i]) & (succA[i] != predB[i]);
+        // A route start in a that is an inner customer in b is broken too.
+        broken += (predA[i] == 0) & (predB[i] != 0) & (succB[i] != 0);
+    }
+    return static_cast<double>(broken) / static_cast<double>(n - 1);
+}
+
+double PopulationDiversity::brokenPairsDistance(const std::vector<std::vector<int>> &a, const std::vector<std::vector<int>> &b,
+                                                std::size_t numNodes)
+{
+    Links linksA, linksB;
+    buildLinks(a, numNodes, linksA);
+    buildLinks(b, numNodes, linksB);
+    return distance(linksA, linksB);
+}
+
+void PopulationDiversity::add(const std::vector<std::vector<int>> &routes)
+{
+    Slot slot;
+    slot.id = nextId++;
+    buildLinks(routes, numNodes, slot.links);
+    slot.closest.reserve(slots.size());
+
+    for (Slot &other : slots)
+    {
+        float d = static_cast<float>(distance(slot.links, other.links));
+        slot.closest.emplace_back(d, other.id);
+        auto entry = std::make_pair(d, slot.id);
+        other.closest.insert(std::upper_bound(other.closest.begin(), other.closest.end(), entry), entry);
+    }
+    std::sort(slot.closest.begin(), slot.closest.end());
+    slots.push_back(std::move(slot));
+}
+
+void PopulationDiversity::remove(std::size_t index)
+{
+    int id = slots[index].id;
+    if (index + 1 != slots.size())
+        slots[index] = std::move(slots.back());
+    slots.pop_back();
+
+    for (Slot &other : slots)
+    {
+        auto it = std::find_if(other.closest.begin(), other.closest.end(), [id](const std::pair<float, int> &entry)
+                               { return entry.second == id; });
+        if (it != other.closest.end())
+            other.closest.erase(it);
+    }
+}
+
+double PopulationDiversity::diversityContribution(std::size_t index, std::size_t numClosest) const
+{
+    const auto &closest = slots[index].closest;
+    std::size_t count = std::min(numClosest, closest.size());
+    if (count == 0)
+        return 0.0;
+    double sum = 0.0;
+    for (std::size_t k = 0; k < count; ++k)
+        sum += closest[k].first;
+    return sum / static_cast<double>(count);
+}
+
+double PopulationDiversity::closestDistance(std::size_t index) const
+{
+    const auto &closest = slots[index].closest;
+    return closest.empty() ? 1.0 : closest.front().first;
+}
+
+std::vector<double> PopulationDiversity::biasedFitness(const std::vector<double> &costs, std::size_t numElite, std::size_t numClosest) const
+{
+    std::size_t n = slots.size();
+    std::vector<double> fitness(n, 0.0);
+    if (n < 2)
+        return fitness;
+
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+              { return costs[a] < costs[b]; });
+    std::vector<double> costRank(n);
+    for (std::size_t r = 0; r < n; ++r)
+        costRank[order[r]] = static_cast<double>(r) / static_cast<double>(n - 1);
+
+    std::vector<double> contribution(n);
+    for (std::size_t i = 0; i < n; ++i)
+        contribution[i] = diversityContribution(i, numClosest);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+              { return contribution[a] > contribution[b]; });
+
+    double diversityWeight = 1.0 - static_cast<double>(std::min(numElite, n)) / static_cast<double>(n);
+    for (std::size_t r = 0; r < n; ++r)
+    {
+        std::size_t i = order[r];
+        fitness[i] = costRank[i] + diversityWeight * static_cast<double>(r) / static_cast<double>(n - 1);
+    }
+    return fitness;
+}
+
+double PopulationDiversity::averageDiversity(std::size_t numClosest) const
+{
+    if (slots.empty())
+        return 0.0;
+    double sum = 0.0;
+    for (std::size_t i = 0; i < slots.size(); ++i)
+        sum += diversityContribution(i, numClosest);
+    return sum / static_cast<double>(slots.size());
+}
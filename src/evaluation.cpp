@@ -0,0 +1,402 @@
+#include "evaluation.hpp"
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+namespace
+{
+
+/**
+ * @brief Evaluation core specialized for a distance policy, a constraint policy, a distance source,
+ * a travel-time source and the symmetry of the distances.
+ */
+template <class Distance, class Constraints, class Source, class TravelTimes, bool Asymmetric>
+class SpecializedCore : public EvaluationCore
+{
+public:
+    using value_type = typename Distance::value_type;
+    using sum_type = typename Distance::sum_type;
+
+    SpecializedCore(const VRP &vrp, const ConstraintPenalties &penalties, Source source, TravelTimes travelTimes)
+        : vrp(vrp), penalties(penalties), numNodes(vrp.getNodes().size()), capacity(vrp.getVehicleCapacity()),
+          source(std::move(source)), travelTimes(std::move(travelTimes))
+    {
+        const std::vector<Node> &nodes = vrp.getNodes();
+        if constexpr (Constraints::usesLoad)
+        {
+            demand.reserve(numNodes);
+            for (const Node &node : nodes)
+                demand.push_back(node.demand);
+        }
+        if constexpr (Constraints::orderDependent)
+        {
+            readyTime.reserve(numNodes);
+            dueDate.reserve(numNodes);
+            serviceTime.reserve(numNodes);
+            for (const Node &node : nodes)
+            {
+                readyTime.push_back(node.readyTime);
+                dueDate.push_back(node.dueDate);
+                serviceTime.push_back(node.serviceTime);
+            }
+        }
+    }
+
+    double routeCost(const std::vector<int> &route) const override
+    {
+        if (route.empty())
+            return 0.0;
+
+        sum_type distance = 0;
+        int load = 0;
+        double time = 0.0;
+        double lateness = 0.0;
+        int prev = 0;
+        for (int customer : route)
+        {
+            value_type leg = d(prev, customer);
+            distance += leg;
+            if constexpr (Constraints::usesLoad)
+                load += demand[customer];
+            if constexpr (Constraints::orderDependent)
+            {
+                time = std::max(time + travel(prev, customer, leg), readyTime[customer]);
+                lateness += std::max(0.0, time - dueDate[customer]);
+                time += serviceTime[customer];
+            }
+            prev = customer;
+        }
+        value_type back = d(prev, 0);
+        distance += back;
+
+        double cost = Distance::toCost(distance);
+        if constexpr (Constraints::usesLoad)
+        {
+            if (capacity > 0 && load > capacity)
+                cost += penalties.capacity * (load - capacity);
+        }
+        if constexpr (Constraints::orderDependent)
+        {
+            time += travel(prev, 0, back);
+            lateness += std::max(0.0, time - dueDate[0]);
+            cost += penalties.lateness * lateness;
+        }
+        return cost;
+    }
+
+    double solutionCost(const std::vector<std::vector<int>> &routes) const override
+    {
+        double totalCost = 0.0;
+        for (const auto &route : routes)
+            totalCost += routeCost(route);
+        return totalCost;
+    }
+
+    void twoOpt(std::vector<int> &route) const override
+    {
+        if (route.size() < 2)
+            return;
+        if (vrp.isLargeInstance())
+            twoOptCandidates(route);
+        else
+            twoOptFull(route);
+    }
+
+private:
+    value_type d(int from, int to) const
+    {
+        if constexpr (std::is_same_v<typename Source::entry_type, value_type>)
+            return source.get(from, to);
+        else
+            return Distance::convert(source.get(from, to));
+    }
+
+    // Travel time of a leg whose evaluated distance is already known.
+    double travel(int from, int to, value_type leg) const
+    {
+        if constexpr (std::is_same_v<TravelTimes, DistanceTravelTimes>)
+            return Distance::toCost(leg);
+        else
+            return travelTimes.get(from, to);
+    }
+
+    // Prefix sums of the leg costs along the route in both directions:
+    // forward[k] sums d(route[t], route[t + 1]) and backward[k] sums
+    // d(route[t + 1], route[t]) for t < k. Only needed for asymmetric distances.
+    void buildPrefixSums(const std::vector<int> &route) const
+    {
+        const std::size_t m = route.size();
+        forward.resize(m);
+        backward.resize(m);
+        forward[0] = 0;
+        backward[0] = 0;
+        for (std::size_t k = 1; k < m; ++k)
+        {
+            forward[k] = forward[k - 1] + d(route[k - 1], route[k]);
+            backward[k] = backward[k - 1] + d(route[k], route[k - 1]);
+        }
+    }
+
+    // Change of the inner cost of route[first..last] when it is traversed backwards.
+    sum_type reversalDelta(int first, int last) const
+    {
+        if constexpr (!Asymmetric)
+            return 0;
+        else
+            return (backward[last] - backward[first]) - (forward[last] - forward[first]);
+    }
+
+    static bool improves(sum_type delta)
+    {
+        if constexpr (std::is_integral_v<sum_type>)
+            return delta < 0;
+        else if constexpr (std::is_same_v<sum_type, float>)
+            return delta < -1e-4f;
+        else
+            return delta < -1e-9;
+    }
+
+    // Applies the reversal of route[first..last] if its distance delta improves.
+    // With order-dependent constraints the full route cost (timing included)
+    // must improve too, otherwise the reversal is undone.
+    bool tryReverse(std::vector<int> &route, int first, int last, sum_type delta) const
+    {
+        if (!improves(delta))
+            return false;
+        if constexpr (Constraints::orderDependent)
+        {
+            double before = routeCost(route);
+            std::reverse(route.begin() + first, route.begin() + last + 1);
+            if (routeCost(route) < before - 1e-9)
+                return true;
+            std::reverse(route.begin() + first, route.begin() + last + 1);
+            return false;
+        }
+        else
+        {
+            std::reverse(route.begin() + first, route.begin() + last + 1);
+            return true;
+        }
+    }
+
+    // Reversing route[i..j] replaces the edges (prev, route[i]) and (route[j], next)
+    // with (prev, route[j]) and (route[i], next); the depot closes both ends.
+    // With asymmetric distances the segment itself also changes direction.
+    void twoOptFull(std::vector<int> &route) const
+    {
+        const int m = static_cast<int>(route.size());
+        bool improved = true;
+        while (improved)
+        {
+            improved = false;
+            if constexpr (Asymmetric)
+                buildPrefixSums(route);
+            for (int i = 0; i < m - 1; ++i)
+            {
+                int prev = i == 0 ? 0 : route[i - 1];
+                for (int j = i + 1; j < m; ++j)
+                {
+                    int next = j == m - 1 ? 0 : route[j + 1];
+                    sum_type delta = static_cast<sum_type>(d(prev, route[j])) + d(route[i], next) -
+                                     d(prev, route[i]) - d(route[j], next) + reversalDelta(i, j);
+                    if (tryReverse(route, i, j, delta))
+                    {
+                        improved = true;
+                        if constexpr (Asymmetric)
+                            buildPrefixSums(route);
+                    }
+                }
+            }
+        }
+    }
+
+    // For every edge (a, succ) only the neighbors of a that are closer than succ
+    // are tried as new successors. With asymmetric distances an outgoing
+    // neighbor of a only bounds the moves that add the edge (a, c); the moves
+    // that add (x, succ) instead are bounded by the incoming neighbors of succ.
+    void twoOptCandidates(std::vector<int> &route) const
+    {
+        const int m = static_cast<int>(route.size());
+        position.resize(numNodes);
+        for (int p = 0; p < m; ++p)
+            position[route[p]] = p;
+
+        // Node at position p, with the depot at -1 and m.
+        auto at = [&](int p)
+        { return (p < 0 || p >= m) ? 0 : route[p]; };
+        // Position of a customer in this route, or -1.
+        auto find = [&](int c)
+        {
+            int q = position[c];
+            return (q < 0 || q >= m || route[q] != c) ? -1 : q;
+        };
+        auto reverseSegment = [&](int first, int last, sum_type delta)
+        {
+            if (!tryReverse(route, first, last, delta + reversalDelta(first, last)))
+                return false;
+            for (int p = first; p <= last; ++p)
+                position[route[p]] = p;
+            if constexpr (Asymmetric)
+                buildPrefixSums(route);
+            return true;
+        };
+        if constexpr (Asymmetric)
+            buildPrefixSums(route);
+
+        bool improved = true;
+        while (improved)
+        {
+            improved = false;
+            for (int p = -1; p < m; ++p)
+            {
+                int a = at(p);
+                int succ = at(p + 1);
+                value_type removed = d(a, succ);
+                bool moved = false;
+                for (int c : vrp.getNeighbors(a))
+                {
+                    value_type added = d(a, c);
+                    if (added >= removed)
+                        break; // Neighbor lists are sorted, no later candidate can gain.
+
+                    int q = find(c);
+                    if (q < 0 || q == p + 1)
+                        continue; // Not in this route, or already the successor.
+
+                    int cNext = at(q + 1);
+                    if (q > p)
+                    {
+                        // Reverse [p + 1, q]: new edges (a, c) and (succ, cNext).
+                        moved = reverseSegment(p + 1, q, static_cast<sum_type>(added) + d(succ, cNext) - removed - d(c, cNext));
+                    }
+                    else if constexpr (!Asymmetric)
+                    {
+                        // Reverse [q + 1, p]: new edges (c, a) and (cNext, succ).
+                        moved = reverseSegment(q + 1, p, static_cast<sum_type>(d(c, a)) + d(cNext, succ) - d(c, cNext) - removed);
+                    }
+                    if (moved)
+                        break;
+                }
+                if constexpr (Asymmetric)
+                {
+                    for (int c : vrp.getIncomingNeighbors(succ))
+                    {
+                        value_type added = d(c, succ);
+                        if (moved || added >= removed)
+                            break;
+
+                        int q = find(c);
+                        if (q < 0 || q >= p)
+                            continue; // Not in this route, a itself, or after succ.
+
+                        // Reverse [q, p]: new edges (cPrev, a) and (c, succ).
+                        int cPrev = at(q - 1);
+                        moved = reverseSegment(q, p, static_cast<sum_type>(d(cPrev, a)) + added - d(cPrev, c) - removed);
+                    }
+                }
+                improved = improved || moved;
+            }
+        }
+    }
+
+    const VRP &vrp;                        ///< Instance.
+    ConstraintPenalties penalties;         ///< Penalty weights.
+    std::size_t numNodes;                  ///< Number of nodes including the depot.
+    int capacity;                          ///< Vehicle capacity (0 for unlimited).
+    std::vector<int> demand;               ///< Demand per node (load-based policies only).
+    std::vector<double> readyTime;         ///< Ready time per node (time windows only).
+    std::vector<double> dueDate;           ///< Due date per node (time windows only).
+    std::vector<double> serviceTime;       ///< Service time per node (time windows only).
+    Source source;                         ///< Where the distances come from.
+    TravelTimes travelTimes;               ///< Where the travel times come from (time windows only).
+    mutable std::vector<int> position;     ///< Reused node -> position map of the candidate 2-opt.
+    mutable std::vector<sum_type> forward;  ///< Forward prefix sums of the route (asymmetric only).
+    mutable std::vector<sum_type> backward; ///< Backward prefix sums of the route (asymmetric only).
+};
+
+template <class Distance, class Constraints, class Source, bool Asymmetric, class TravelTimes>
+std::unique_ptr<EvaluationCore> makeCore(const VRP &vrp, const ConstraintPenalties &penalties, Source source, TravelTimes travelTimes)
+{
+    return std::make_unique<SpecializedCore<Distance, Constraints, Source, TravelTimes, Asymmetric>>(
+        vrp, penalties, std::move(source), std::move(travelTimes));
+}
+
+// Only time windows read travel times: a mapped travel-time matrix in its
+// stored type, otherwise the evaluated distances.
+template <class Distance, class Source, bool Asymmetric>
+std::unique_ptr<EvaluationCore> makeCoreWith(const VRP &vrp, ConstraintType constraintType, const ConstraintPenalties &penalties,
+                                             Source source)
+{
+    switch (constraintType)
+    {
+    case ConstraintType::Capacity:
+        return makeCore<Distance, CapacityConstraints, Source, Asymmetric>(vrp, penalties, std::move(source), DistanceTravelTimes{});
+    case ConstraintType::TimeWindows:
+        if (const MappedMatrix *file = vrp.getDurationFile())
+        {
+            const std::size_t n = vrp.getNodes().size();
+            if (file->valueType() == MatrixValueType::Float32)
+                return makeCore<Distance, TimeWindowConstraints, Source, Asymmetric>(vrp, penalties, std::move(source),
+                                                                                     MatrixSource<float>{file->float32Values(), n});
+            return makeCore<Distance, TimeWindowConstraints, Source, Asymmetric>(vrp, penalties, std::move(source),
+                                                                                 MatrixSource<double>{file->float64Values(), n});
+        }
+        return makeCore<Distance, TimeWindowConstraints, Source, Asymmetric>(vrp, penalties, std::move(source), DistanceTravelTimes{});
+    case ConstraintType::Unconstrained:
+    default:
+        return makeCore<Distance, NoConstraints, Source, Asymmetric>(vrp, penalties, std::move(source), DistanceTravelTimes{});
+    }
+}
+
+// A matrix file is the only source that can be asymmetric.
+template <class Distance, class Entry>
+std::unique_ptr<EvaluationCore> makeCoreWithFile(const VRP &vrp, ConstraintType constraintType, const ConstraintPenalties &penalties,
+                                                 MatrixSource<Entry> source)
+{
+    if (vrp.isSymmetric())
+        return makeCoreWith<Distance, MatrixSource<Entry>, false>(vrp, constraintType, penalties, source);
+    return makeCoreWith<Distance, MatrixSource<Entry>, true>(vrp, constraintType, penalties, source);
+}
+
+// Picks the distance source: a mapped matrix file is read in place in its
+// stored type, the instance's own dense matrix directly for double distances
+// and through a converted copy for the other policies, and the coordinates in
+// large-instance mode.
+template <class Distance>
+std::unique_ptr<EvaluationCore> makeCoreFor(const VRP &vrp, ConstraintType constraintType, const ConstraintPenalties &penalties)
+{
+    const std::size_t n = vrp.getNodes().size();
+    if (const MappedMatrix *file = vrp.getDistanceFile())
+    {
+        if (file->valueType() == MatrixValueType::Float32)
+            return makeCoreWithFile<Distance>(vrp, constraintType, penalties, MatrixSource<float>{file->float32Values(), n});
+        return makeCoreWithFile<Distance>(vrp, constraintType, penalties, MatrixSource<double>{file->float64Values(), n});
+    }
+    if (vrp.isLargeInstance())
+        return makeCoreWith<Distance, EuclideanSource, false>(vrp, constraintType, penalties, EuclideanSource(vrp));
+    if constexpr (std::is_same_v<Distance, DoubleDistance>)
+        return makeCoreWith<Distance, MatrixSource<double>, false>(vrp, constraintType, penalties,
+                                                                   MatrixSource<double>{vrp.getDistanceMatrix().data(), n});
+    else
+        return makeCoreWith<Distance, ConvertedMatrixSource<Distance>, false>(vrp, constraintType, penalties,
+                                                                              ConvertedMatrixSource<Distance>(vrp));
+}
+
+} // namespace
+
+std::unique_ptr<EvaluationCore> makeEvaluationCore(const VRP &vrp, DistanceType distanceType, ConstraintType constraintType,
+                                                   const ConstraintPenalties &penalties)
+{
+    switch (distanceType)
+    {
+    case DistanceType::Float:
+        return makeCoreFor<FloatDistance>(vrp, constraintType, penalties);
+    case DistanceType::ScaledInteger:
+        return makeCoreFor<ScaledIntegerDistance<10, true>>(vrp, constraintType, penalties);
+    case DistanceType::RoundedInteger:
+        return makeCoreFor<ScaledIntegerDistance<1, false>>(vrp, constraintType, penalties);
+    case DistanceType::Double:
+    default:
+        return makeCoreFor<DoubleDistance>(vrp, constraintType, penalties);
+    }
+}
@@ -4,22 +4,30 @@
 #include <iostream>
 #include <chrono>
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <numeric>
 #include <stdexcept>
-#include <unordered_set>
-#include <unordered_map>
 
-GeneticAlgorithm::GeneticAlgorithm(VRP &vrp, SelectionMethod selMethod, int tourSize)
+// Helper function returning the milliseconds elapsed since a time point.
+static inline double elapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+GeneticAlgorithm::GeneticAlgorithm(const VRP &vrp, SelectionMethod selMethod, int tourSize)
     : vrp(vrp), bestCost(std::numeric_limits<double>::max()),
       selectionMethod(selMethod), tournamentSize(tourSize)
 {
     rng.seed(std::chrono::steady_clock::now().time_since_epoch().count());
+    setMutationMethod(mutationMethod, ruinRemovalSize);
+    setEvaluation(DistanceType::Double, ConstraintType::Unconstrained);
 }
 
 void GeneticAlgorithm::initializePopulation(int populationSize)
 {
     population.clear();
+    populationCosts.clear();
     const std::vector<Node> &nodes = vrp.getNodes();
     int numNodes = static_cast<int>(nodes.size());
     if (numNodes == 0)
@@ -50,27 +58,114 @@ void GeneticAlgorithm::initializePopulation(int populationSize)
 
         population.push_back(routes);
         double cost = evaluateSolution(routes);
+        populationCosts.push_back(cost);
         if (cost < bestCost)
         {
             bestCost = cost;
             bestSolution = routes;
         }
     }
+    updateSelectionCache();
+    rebuildDiversity();
+}
+void GeneticAlgorithm::initializePopulation(const std::vector<std::vector<std::vector<int>>> &seeds, int populationSize)
+{
+    if (seeds.empty() || vrp.getNodes().size() < 2)
+    {
+        initializePopulation(populationSize);
+        return;
+    }
+
+    population.clear();
+    populationCosts.clear();
+    bestCost = std::numeric_limits<double>::max();
+    bestSolution.clear();
+
+    std::size_t numSeeds = std::min(seeds.size(), static_cast<std::size_t>(std::max(populationSize, 1)));
+    for (std::size_t i = 0; i < numSeeds; ++i)
+    {
+        std::vector<std::vector<int>> routes = seeds[i];
+        repairSolution(routes);
+        population.push_back(std::move(routes));
+    }
+    for (std::size_t i = numSeeds; i < static_cast<std::size_t>(populationSize); ++i)
+    {
+        std::vector<std::vector<int>> routes = population[i % numSeeds];
+        ruinRecreate(routes);
+        population.push_back(std::move(routes));
+    }
+
+    for (const auto &routes : population)
+    {
+        double cost = evaluateAndPool(routes);
+        populationCosts.push_back(cost);
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestSolution = routes;
+        }
+    }
+    updateSelectionCache();
+    rebuildDiversity();
+}
+
+void GeneticAlgorithm::repairSolution(std::vector<std::vector<int>> &routes) const
+{
+    const int numNodes = static_cast<int>(vrp.getNodes().size());
+    const std::size_t numVehicles = static_cast<std::size_t>(std::max(vrp.getNumVehicles(), 1));
+
+    std::vector<char> seen(numNodes, 0);
+    std::vector<int> missing;
+    for (std::size_t r = 0; r < routes.size(); ++r)
+    {
+        std::vector<int> &route = routes[r];
+        auto keep = [&](int customer)
+        {
+            if (customer <= 0 || customer >= numNodes || seen[customer])
+                return false;
+            seen[customer] = 1;
+            return true;
+        };
+        route.erase(std::remove_if(route.begin(), route.end(), [&](int customer)
+                                   { return !keep(customer); }),
+                    route.end());
+        // Routes beyond the fleet size are dissolved and their customers reinserted.
+        if (r >= numVehicles)
+            missing.insert(missing.end(), route.begin(), route.end());
+    }
+    routes.resize(numVehicles);
+
+    for (int customer = 1; customer < numNodes; ++customer)
+    {
+        if (!seen[customer])
+            missing.push_back(customer);
+    }
+    std::shuffle(missing.begin(), missing.end(), rng);
+    insertCustomers(routes, missing);
+    for (auto &route : routes)
+        twoOpt(route);
 }
+
 double GeneticAlgorithm::evaluateSolution(const std::vector<std::vector<int>> &routes) const
 {
+    return evaluation->solutionCost(routes);
+}
+
+double GeneticAlgorithm::evaluateAndPool(const std::vector<std::vector<int>> &routes)
+{
+    if (!routePool)
+        return evaluateSolution(routes);
     double totalCost = 0.0;
     for (const auto &route : routes)
     {
-        if (!route.empty())
-        {
-            totalCost += vrp.computeRouteCost(route);
-        }
+        double cost = evaluation->routeCost(route);
+        routePool->add(route, cost);
+        totalCost += cost;
     }
     return totalCost;
 }
 
-std::vector<std::vector<int>> GeneticAlgorithm::tournamentSelection() const
+std::size_t GeneticAlgorithm::tournamentSelection() const
 {
     int popSize = population.size();
     if (popSize == 0)
@@ -78,50 +173,43 @@ std::vector<std::vector<int>> GeneticAlgorithm::tournamentSelection() const
 
     std::uniform_int_distribution<int> dist(0, popSize - 1);
     int bestIndex = dist(rng);
-    double bestCostLocal = evaluateSolution(population[bestIndex]);
     for (int k = 1; k < tournamentSize; ++k)
     {
         int idx = dist(rng);
-        double cost = evaluateSolution(population[idx]);
-        if (cost < bestCostLocal)
+        if (populationCosts[idx] < populationCosts[bestIndex])
         {
-            bestCostLocal = cost;
             bestIndex = idx;
         }
     }
-    return population[bestIndex];
+    return static_cast<std::size_t>(bestIndex);
 }
-std::vector<std::vector<int>> GeneticAlgorithm::rouletteSelection() const
+std::size_t GeneticAlgorithm::rouletteSelection() const
 {
     int popSize = population.size();
     if (popSize == 0)
         throw std::runtime_error("Population is empty during roulette selection.");
 
-    // Calculate fitness values (lower cost => higher fitness)
-    std::vector<double> fitness(popSize);
+    // Binary search in the cumulative fitness (lower cost => higher fitness)
+    std::uniform_real_distribution<double> dist(0.0, rouletteCumulative.back());
+    double r = dist(rng);
+    auto it = std::lower_bound(rouletteCumulative.begin(), rouletteCumulative.end(), r);
+    if (it == rouletteCumulative.end())
+        return population.size() - 1; // Fallback
+    return static_cast<std::size_t>(it - rouletteCumulative.begin());
+}
+
+void GeneticAlgorithm::updateSelectionCache()
+{
+    rouletteCumulative.resize(populationCosts.size());
     double totalFitness = 0.0;
-    for (int i = 0; i < popSize; ++i)
+    for (std::size_t i = 0; i < populationCosts.size(); ++i)
     {
-        double cost = evaluateSolution(population[i]);
-        double fit = 1.0 / (cost + 1e-6); // Avoid division by zero
-        fitness[i] = fit;
-        totalFitness += fit;
+        totalFitness += 1.0 / (populationCosts[i] + 1e-6); // Avoid division by zero
+        rouletteCumulative[i] = totalFitness;
     }
-    std::uniform_real_distribution<double> dist(0.0, totalFitness);
-    double r = dist(rng);
-    double cumulative = 0.0;
-    for (int i = 0; i < popSize; ++i)
-    {
-        cumulative += fitness[i];
-        if (cumulative >= r)
-        {
-            return population[i];
-        }
-    }
-    return population.back(); // Fallback
 }
 
-std::vector<std::vector<int>> GeneticAlgorithm::selectParent() const
+std::size_t GeneticAlgorithm::selectParent() const
 {
     if (selectionMethod == SelectionMethod::Tournament)
         return tournamentSelection();
@@ -143,6 +231,189 @@ void GeneticAlgorithm::mutate(std::vector<std::vector<int>> &routes) const
     std::swap(routes[vehicle][i], routes[vehicle][j]);
 }
 
+void GeneticAlgorithm::ruinRecreate(std::vector<std::vector<int>> &routes) const
+{
+    const std::vector<Node> &nodes = vrp.getNodes();
+    int numCustomers = static_cast<int>(nodes.size()) - 1;
+    if (numCustomers < 2 || routes.empty() || ruinRemovalSize <= 0)
+        return;
+
+    std::vector<int> routeOf(nodes.size(), -1);
+    int nonEmptyRoutes = 0;
+    for (std::size_t r = 0; r < routes.size(); ++r)
+    {
+        if (!routes[r].empty())
+            ++nonEmptyRoutes;
+        for (int customer : routes[r])
+            routeOf[customer] = static_cast<int>(r);
+    }
+
+    std::size_t target = std::min(ruinRemovalSize, numCustomers);
+    int maxStringLength = std::max(1, std::min(10, numCustomers / std::max(1, nonEmptyRoutes)));
+
+    std::uniform_int_distribution<int> customerDist(1, numCustomers);
+    std::uniform_real_distribution<double> probDist(0.0, 1.0);
+    int seed = customerDist(rng);
+    bool stringRemoval = probDist(rng) < 0.5;
+
+    std::vector<char> removed(nodes.size(), 0);
+    std::vector<char> ruinedRoute(routes.size(), 0);
+    std::vector<int> removedCustomers;
+
+    // Walk the seed and its neighbors, closest first, so the removed set is spatially correlated.
+    std::vector<int> order;
+    order.push_back(seed);
+    const std::vector<int> &seedNeighbors = vrp.getNeighbors(seed);
+    order.insert(order.end(), seedNeighbors.begin(), seedNeighbors.end());
+
+    for (int customer : order)
+    {
+        if (removedCustomers.size() >= target)
+            break;
+        if (removed[customer])
+            continue;
+
+        if (!stringRemoval)
+        {
+            removed[customer] = 1;
+            removedCustomers.push_back(customer);
+            continue;
+        }
+
+        // String removal: cut one string of consecutive customers per route.
+        int r = routeOf[customer];
+        if (r < 0 || ruinedRoute[r])
+            continue;
+        ruinedRoute[r] = 1;
+
+        const std::vector<int> &route = routes[r];
+        int routeSize = static_cast<int>(route.size());
+        int pos = static_cast<int>(std::find(route.begin(), route.end(), customer) - route.begin());
+        int maxLength = std::min({maxStringLength, routeSize, static_cast<int>(target - removedCustomers.size())});
+        std::uniform_int_distribution<int> lengthDist(1, maxLength);
+        int length = lengthDist(rng);
+        std::uniform_int_distribution<int> startDist(std::max(0, pos - length + 1), std::min(pos, routeSize - length));
+        int start = startDist(rng);
+        for (int i = start; i < start + length; ++i)
+        {
+            removed[route[i]] = 1;
+            removedCustomers.push_back(route[i]);
+        }
+    }
+
+    for (auto &route : routes)
+    {
+        route.erase(std::remove_if(route.begin(), route.end(), [&](int c)
+                                   { return removed[c] != 0; }),
+                    route.end());
+    }
+
+    std::shuffle(removedCustomers.begin(), removedCustomers.end(), rng);
+    insertCustomers(routes, removedCustomers);
+}
+
+void GeneticAlgorithm::insertCustomers(std::vector<std::vector<int>> &routes, std::vector<int> &customers) const
+{
+    const std::vector<Node> &nodes = vrp.getNodes();
+    int capacity = vrp.getVehicleCapacity();
+    bool restricted = vrp.isLargeInstance();
+
+    std::vector<int> loads(routes.size(), 0);
+    for (std::size_t r = 0; r < routes.size(); ++r)
+    {
+        for (int customer : routes[r])
+            loads[r] += nodes[customer].demand;
+    }
+
+    // In large-instance mode only the positions next to the routed neighbors of
+    // a customer (and one empty route) are evaluated.
+    std::vector<int> &routeOf = routeScratch;
+    std::vector<int> &position = positionScratch;
+    int emptyRoute = -1;
+    if (restricted)
+    {
+        routeOf.assign(nodes.size(), -1);
+        position.resize(nodes.size());
+        for (std::size_t r = 0; r < routes.size(); ++r)
+        {
+            if (routes[r].empty() && emptyRoute < 0)
+                emptyRoute = static_cast<int>(r);
+            for (std::size_t p = 0; p < routes[r].size(); ++p)
+            {
+                routeOf[routes[r][p]] = static_cast<int>(r);
+                position[routes[r][p]] = static_cast<int>(p);
+            }
+        }
+    }
+
+    for (int customer : customers)
+    {
+        int demand = nodes[customer].demand;
+        double bestDelta = std::numeric_limits<double>::max();
+        bool bestFeasible = false;
+        int bestRoute = -1;
+        std::size_t bestPos = 0;
+
+        auto consider = [&](int r, std::size_t pos)
+        {
+            bool feasible = capacity <= 0 || loads[r] + demand <= capacity;
+            if (!feasible && bestFeasible)
+                return;
+
+            const std::vector<int> &route = routes[r];
+            int prev = pos > 0 ? route[pos - 1] : 0;
+            int next = pos < route.size() ? route[pos] : 0;
+            double delta = vrp.dist(prev, customer) + vrp.dist(customer, next) - vrp.dist(prev, next);
+            if ((feasible && !bestFeasible) || delta < bestDelta)
+            {
+                bestDelta = delta;
+                bestFeasible = feasible;
+                bestRoute = r;
+                bestPos = pos;
+            }
+        };
+
+        if (restricted)
+        {
+            for (int neighbor : vrp.getNeighbors(customer))
+            {
+                int r = routeOf[neighbor];
+                if (r < 0)
+                    continue;
+                consider(r, position[neighbor]);
+                consider(r, position[neighbor] + 1);
+            }
+            if (emptyRoute >= 0)
+                consider(emptyRoute, 0);
+        }
+
+        if (bestRoute < 0)
+        {
+            for (std::size_t r = 0; r < routes.size(); ++r)
+            {
+                for (std::size_t pos = 0; pos <= routes[r].size(); ++pos)
+                    consider(static_cast<int>(r), pos);
+            }
+        }
+
+        if (bestRoute < 0)
+            continue;
+        std::vector<int> &route = routes[bestRoute];
+        route.insert(route.begin() + bestPos, customer);
+        loads[bestRoute] += demand;
+
+        if (restricted)
+        {
+            routeOf[customer] = bestRoute;
+            for (std::size_t p = bestPos; p < route.size(); ++p)
+                position[route[p]] = static_cast<int>(p);
+            while (emptyRoute >= 0 && !routes[emptyRoute].empty())
+                emptyRoute = emptyRoute + 1 < static_cast<int>(routes.size()) ? emptyRoute + 1 : -1;
+        }
+    }
+    customers.clear();
+}
+
 std::vector<std::vector<int>> GeneticAlgorithm::pmxCrossover(
     const std::vector<std::vector<int>> &parent1,
     const std::vector<std::vector<int>> &parent2) const
@@ -167,52 +438,35 @@ std::vector<std::vector<int>> GeneticAlgorithm::pmxCrossover(
     for (std::vector<int>::size_type i = cut1; i <= cut2; ++i)
         child[i] = flat1[i];
 
-    std::unordered_map<int, int> mapping;
+    // Customers of flat2 outside the segment keep their position unless the
+    // segment already holds them; the remaining gaps are filled with the
+    // missing customers in ascending order. Linear in the number of customers.
+    std::vector<char> used(size + 1, 0);
     for (std::vector<int>::size_type i = cut1; i <= cut2; ++i)
-    {
-        mapping[flat2[i]] = flat1[i];
-    }
+        used[child[i]] = 1;
 
-    std::unordered_set<int> used(child.begin(), child.end());
     for (std::vector<int>::size_type i = 0; i < size; ++i)
     {
         if (i >= cut1 && i <= cut2)
             continue;
 
         int candidate = flat2[i];
-        std::unordered_set<int> visited;
-        while (mapping.find(candidate) != mapping.end())
-        {
-            if (visited.find(candidate) != visited.end())
-            {
-                std::cerr << "Cycle detected in mapping for candidate: " << candidate << std::endl;
-                break;
-            }
-            visited.insert(candidate);
-            candidate = mapping[candidate];
-        }
-
-        if (used.find(candidate) != used.end())
+        if (used[candidate])
             continue;
 
         child[i] = candidate;
-        used.insert(candidate);
+        used[candidate] = 1;
     }
 
+    std::vector<int>::size_type slot = 0;
     for (int i = 1; i <= static_cast<int>(size); ++i)
     {
-        if (used.find(i) == used.end())
-        {
-            for (std::vector<int>::size_type j = 0; j < size; ++j)
-            {
-                if (child[j] == -1)
-                {
-                    child[j] = i;
-                    used.insert(i);
-                    break;
-                }
-            }
-        }
+        if (used[i])
+            continue;
+        while (child[slot] != -1)
+            ++slot;
+        child[slot] = i;
+        used[i] = 1;
     }
 
     std::vector<std::vector<int>> offspring(maxVehicles);
@@ -304,48 +558,19 @@ std::vector<std::vector<int>> GeneticAlgorithm::pmxCrossover(
 
 void GeneticAlgorithm::twoOpt(std::vector<int> &route) const
 {
-    if (route.size() < 2)
-        return;
-
-    bool improved = true;
-    double currentCost = vrp.computeRouteCost(route);
-    while (improved)
-    {
-        improved = false;
-        for (size_t i = 1; i < route.size() - 2; ++i)
-        {
-            for (size_t j = i + 1; j < route.size() - 1; ++j)
-            {
-                std::reverse(route.begin() + i, route.begin() + j + 1);
-                double newCost = vrp.computeRouteCost(route);
-                if (newCost < currentCost)
-                {
-                    currentCost = newCost;
-                    improved = true;
-                }
-                else
-                {
-                    std::reverse(route.begin() + i, route.begin() + j + 1);
-                }
-            }
-        }
-    }
+    evaluation->twoOpt(route);
 }
 
 void GeneticAlgorithm::reproduce()
 {
-    double crossoverProbability = 0.85;
-    double mutationProbability = 0.1;
-    double twoOptProbability = 0.1;
-    double forBestSolutiuonsTwoOptProbability = 0.5;
-
-    std::vector<std::vector<std::vector<int>>> newPopulation;
+    using Clock = std::chrono::steady_clock;
 
     std::vector<std::pair<double, std::vector<std::vector<int>>>> bestSolutions;
 
-    for (const auto &ind : population)
+    for (std::size_t i = 0; i < population.size(); ++i)
     {
-        double cost = evaluateSolution(ind);
+        const auto &ind = population[i];
+        double cost = populationCosts[i];
         if (bestSolutions.size() < 10)
         {
             bestSolutions.emplace_back(cost, ind);
@@ -360,59 +585,79 @@ void GeneticAlgorithm::reproduce()
 
     std::uniform_real_distribution<double> probDist(0.0, 1.0);
 
-    for (auto &solution : bestSolutions)
+    std::vector<char> eliteImproved(bestSolutions.size(), 0);
+    for (std::size_t i = 0; i < bestSolutions.size(); ++i)
     {
-        if (probDist(rng) < forBestSolutiuonsTwoOptProbability)
+        auto &solution = bestSolutions[i];
+        if (probDist(rng) < scheduler.rate(Operator::EliteTwoOpt))
         {
+            auto start = Clock::now();
             for (auto &route : solution.second)
             {
                 twoOpt(route);
             }
-            solution.first = evaluateSolution(solution.second);
+            double ms = elapsedMs(start);
+            double cost = evaluateAndPool(solution.second);
+            scheduler.record(Operator::EliteTwoOpt, solution.first - cost, ms);
+            eliteImproved[i] = cost < solution.first;
+            solution.first = cost;
         }
     }
 
-    for (const auto &solution : bestSolutions)
-    {
-        newPopulation.push_back(solution.second);
-    }
-
-    while (newPopulation.size() < population.size())
+    std::size_t targetSize = population.size();
+    if (survivorSelection == SurvivorSelection::Elitist)
     {
-        auto parent1 = selectParent();
-        auto parent2 = selectParent();
-        while (parent1 == parent2)
+        std::vector<std::vector<std::vector<int>>> newPopulation;
+        std::vector<double> newCosts;
+        for (const auto &solution : bestSolutions)
         {
-            parent2 = selectParent();
+            newPopulation.push_back(solution.second);
+            newCosts.push_back(solution.first);
         }
 
-        std::vector<std::vector<int>> offspring;
-        if (probDist(rng) < crossoverProbability)
+        while (newPopulation.size() < targetSize)
         {
-            offspring = pmxCrossover(parent1, parent2);
+            double cost = 0.0;
+            newPopulation.push_back(makeOffspring(cost));
+            newCosts.push_back(cost);
         }
-        else
+
+        population = std::move(newPopulation);
+        populationCosts = std::move(newCosts);
+    }
+    else
+    {
+        // Offspring and improved elites join the population, then the survivors
+        // are chosen by biased fitness.
+        std::vector<std::pair<double, std::vector<std::vector<int>>>> offspring;
+        for (std::size_t i = 0; i < bestSolutions.size(); ++i)
         {
-            offspring = parent1;
+            if (eliteImproved[i])
+                offspring.push_back(bestSolutions[i]);
         }
-
-        if (probDist(rng) < mutationProbability)
+        for (std::size_t k = 0; k < targetSize; ++k)
         {
-            mutate(offspring);
+            double cost = 0.0;
+            auto child = makeOffspring(cost);
+            offspring.emplace_back(cost, std::move(child));
         }
 
-        for (auto &route : offspring)
+        auto start = Clock::now();
+        for (auto &child : offspring)
         {
-            if (probDist(rng) < twoOptProbability)
+            if (child.first < bestCost)
             {
-                twoOpt(route);
+                bestCost = child.first;
+                bestSolution = child.second;
             }
+            addIndividual(std::move(child.second), child.first);
         }
-
-        newPopulation.push_back(offspring);
+        selectSurvivors(targetSize);
+        survivorSelectionMs += elapsedMs(start);
     }
 
-    population = newPopulation;
+    updateSelectionCache();
+    scheduler.endSegment();
 
     for (const auto &solution : bestSolutions)
     {
@@ -423,6 +668,145 @@ void GeneticAlgorithm::reproduce()
         }
     }
 }
+
+std::vector<std::vector<int>> GeneticAlgorithm::makeOffspring(double &offspringCost)
+{
+    using Clock = std::chrono::steady_clock;
+    std::uniform_real_distribution<double> probDist(0.0, 1.0);
+
+    std::size_t parent1 = selectParent();
+    std::size_t parent2 = selectParent();
+    // Bounded, so a population of clones cannot stall reproduction.
+    for (int attempt = 0; attempt < 10 && population[parent1] == population[parent2]; ++attempt)
+    {
+        parent2 = selectParent();
+    }
+
+    std::vector<std::vector<int>> offspring;
+    offspringCost = populationCosts[parent1];
+    if (probDist(rng) < scheduler.rate(Operator::Crossover))
+    {
+        double parentCost = std::min(offspringCost, populationCosts[parent2]);
+        auto start = Clock::now();
+        offspring = pmxCrossover(population[parent1], population[parent2]);
+        double ms = elapsedMs(start);
+        offspringCost = evaluateSolution(offspring);
+        scheduler.record(Operator::Crossover, parentCost - offspringCost, ms);
+    }
+    else
+    {
+        offspring = population[parent1];
+    }
+
+    for (Operator op : {Operator::SwapMutation, Operator::RuinRecreate})
+    {
+        if (probDist(rng) < scheduler.rate(op))
+        {
+            auto start = Clock::now();
+            if (op == Operator::RuinRecreate)
+                ruinRecreate(offspring);
+            else
+                mutate(offspring);
+            double ms = elapsedMs(start);
+            double cost = evaluateSolution(offspring);
+            scheduler.record(op, offspringCost - cost, ms);
+            offspringCost = cost;
+        }
+    }
+
+    for (auto &route : offspring)
+    {
+        if (probDist(rng) < scheduler.rate(Operator::TwoOpt))
+        {
+            double routeCost = evaluation->routeCost(route);
+            auto start = Clock::now();
+            twoOpt(route);
+            double ms = elapsedMs(start);
+            double improvedCost = evaluation->routeCost(route);
+            scheduler.record(Operator::TwoOpt, routeCost - improvedCost, ms);
+            offspringCost -= routeCost - improvedCost;
+            if (routePool)
+                routePool->add(route, improvedCost);
+        }
+    }
+    return offspring;
+}
+
+void GeneticAlgorithm::addIndividual(std::vector<std::vector<int>> routes, double cost)
+{
+    if (survivorSelection == SurvivorSelection::BiasedFitness)
+        diversity.add(routes);
+    population.push_back(std::move(routes));
+    populationCosts.push_back(cost);
+}
+
+void GeneticAlgorithm::removeIndividual(std::size_t index)
+{
+    if (survivorSelection == SurvivorSelection::BiasedFitness)
+        diversity.remove(index);
+    if (index + 1 != population.size())
+    {
+        population[index] = std::move(population.back());
+        populationCosts[index] = populationCosts.back();
+    }
+    population.pop_back();
+    populationCosts.pop_back();
+}
+
+void GeneticAlgorithm::selectSurvivors(std::size_t targetSize)
+{
+    while (population.size() > targetSize)
+    {
+        // Clones go first, the costlier one of each pair; they need no ranking.
+        std::size_t worst = population.size();
+        for (std::size_t i = 0; i < population.size(); ++i)
+        {
+            if (diversity.closestDistance(i) == 0.0 && (worst == population.size() || populationCosts[i] > populationCosts[worst]))
+                worst = i;
+        }
+        if (worst == population.size())
+        {
+            std::vector<double> fitness = diversity.biasedFitness(populationCosts, numEliteSurvivors, numClosestNeighbors);
+            worst = static_cast<std::size_t>(std::max_element(fitness.begin(), fitness.end()) - fitness.begin());
+        }
+        removeIndividual(worst);
+    }
+}
+
+void GeneticAlgorithm::recombineRoutes()
+{
+    std::size_t numCustomers = vrp.getNodes().size() - 1;
+    if (routePool->size() == 0 || numCustomers == 0)
+        return;
+
+    // An uncovered customer is estimated at the average cost per customer of the best solution.
+    double uncoveredPenalty = bestCost / static_cast<double>(numCustomers);
+    std::vector<std::vector<int>> routes;
+    routePool->assemble(static_cast<std::size_t>(std::max(vrp.getNumVehicles(), 1)), uncoveredPenalty, routes);
+
+    double previousBest = bestCost;
+    injectSolution(std::move(routes));
+    if (bestCost < previousBest)
+        ++setPartitioningImprovements;
+}
+
+void GeneticAlgorithm::setRoutePool(std::shared_ptr<RoutePool> pool, int interval)
+{
+    routePool = std::move(pool);
+    setPartitioningInterval = std::max(interval, 1);
+    if (routePool && (routePool->getNumNodes() != vrp.getNodes().size() || routePool->getInstanceRevision() != vrp.getRevision()))
+        routePool->reset(vrp.getNodes().size(), vrp.getRevision());
+}
+
+void GeneticAlgorithm::rebuildDiversity()
+{
+    diversity.reset(vrp.getNodes().size());
+    if (survivorSelection != SurvivorSelection::BiasedFitness)
+        return;
+    for (const auto &individual : population)
+        diversity.add(individual);
+}
+
 void GeneticAlgorithm::run(int generations)
 {
     if (population.empty())
@@ -432,9 +816,47 @@ void GeneticAlgorithm::run(int generations)
     for (int gen = 0; gen < generations; ++gen)
     {
         reproduce();
+        ++generationsRun;
+        if (routePool && generationsRun % setPartitioningInterval == 0)
+            recombineRoutes();
     }
 }
 
+void GeneticAlgorithm::injectSolution(std::vector<std::vector<int>> routes)
+{
+    repairSolution(routes);
+    double cost = evaluateAndPool(routes);
+    if (cost < bestCost)
+    {
+        bestCost = cost;
+        bestSolution = routes;
+    }
+    if (population.empty())
+    {
+        addIndividual(std::move(routes), cost);
+        updateSelectionCache();
+        return;
+    }
+
+    std::size_t size = population.size();
+    addIndividual(std::move(routes), cost);
+    if (survivorSelection == SurvivorSelection::BiasedFitness)
+    {
+        selectSurvivors(size);
+    }
+    else
+    {
+        auto worst = std::max_element(populationCosts.begin(), populationCosts.end());
+        removeIndividual(static_cast<std::size_t>(worst - populationCosts.begin()));
+    }
+    updateSelectionCache();
+}
+
+const std::vector<std::vector<std::vector<int>>> &GeneticAlgorithm::getPopulation() const
+{
+    return population;
+}
+
 std::vector<std::vector<int>> GeneticAlgorithm::getBestSolution() const
 {
     return bestSolution;
@@ -444,3 +866,69 @@ double GeneticAlgorithm::getBestSolutionCost() const
 {
     return bestCost;
 }
+
+void GeneticAlgorithm::setMutationMethod(MutationMethod method, int removalSize)
+{
+    mutationMethod = method;
+    ruinRemovalSize = removalSize;
+    scheduler.setBaseRate(Operator::SwapMutation, method == MutationMethod::Swap ? 0.1 : 0.0);
+    scheduler.setBaseRate(Operator::RuinRecreate, method == MutationMethod::RuinRecreate ? 0.1 : 0.0);
+}
+
+void GeneticAlgorithm::setAdaptiveOperators(bool enabled)
+{
+    scheduler.setAdaptive(enabled);
+}
+
+const OperatorScheduler &GeneticAlgorithm::getOperatorScheduler() const
+{
+    return scheduler;
+}
+
+void GeneticAlgorithm::setEvaluation(DistanceType distanceType, ConstraintType constraintType, const ConstraintPenalties &penalties)
+{
+    evaluation = makeEvaluationCore(vrp, distanceType, constraintType, penalties);
+
+    // Costs of an existing population are no longer comparable; re-evaluate them.
+    bestCost = std::numeric_limits<double>::max();
+    for (std::size_t i = 0; i < population.size(); ++i)
+    {
+        populationCosts[i] = evaluateSolution(population[i]);
+        if (populationCosts[i] < bestCost)
+        {
+            bestCost = populationCosts[i];
+            bestSolution = population[i];
+        }
+    }
+    if (!population.empty())
+        updateSelectionCache();
+}
+
+void GeneticAlgorithm::setSurvivorSelection(SurvivorSelection method, int numElite, int numClosest)
+{
+    survivorSelection = method;
+    numEliteSurvivors = static_cast<std::size_t>(std::max(0, numElite));
+    numClosestNeighbors = static_cast<std::size_t>(std::max(1, numClosest));
+    rebuildDiversity();
+}
+
+double GeneticAlgorithm::getSurvivorSelectionMs() const
+{
+    return survivorSelectionMs;
+}
+
+double GeneticAlgorithm::getPopulationDiversity() const
+{
+    if (survivorSelection == SurvivorSelection::BiasedFitness)
+        return diversity.averageDiversity(numClosestNeighbors);
+
+    PopulationDiversity snapshot(vrp.getNodes().size());
+    for (const auto &individual : population)
+        snapshot.add(individual);
+    return snapshot.averageDiversity(numClosestNeighbors);
+}
+
+void GeneticAlgorithm::setSeed(unsigned int seed)
+{
+    rng.seed(seed);
+}
@@ -0,0 +1,840 @@
+#include "island.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+namespace
+{
+    constexpr std::uint32_t SegmentMagic = 0x56525049; // "VRPI"
+    constexpr std::uint32_t SlotsPerRing = 8;
+    constexpr std::size_t CacheLine = 64;
+
+    constexpr char FrameHello = 1; // Payload: varint islandFingerprint().
+    constexpr char FrameElite = 2; // Payload: encodeSolution().
+    constexpr char FrameStop = 3;  // No payload.
+    constexpr std::size_t FrameHeaderSize = 5;
+    constexpr std::uint32_t MaxFramePayload = 1u << 30;
+
+    std::size_t alignUp(std::size_t value, std::size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    constexpr std::size_t MaxOutbox = 64u << 20; // Elites are dropped while more is queued.
+
+    // Frames are a type byte, a little-endian 32-bit payload length and the payload.
+    void appendFrame(std::string &outbox, char type, const std::string &payload)
+    {
+        outbox.push_back(type);
+        std::uint32_t length = static_cast<std::uint32_t>(payload.size());
+        for (int i = 0; i < 4; ++i)
+            outbox.push_back(static_cast<char>((length >> (8 * i)) & 0xFF));
+        outbox += payload;
+    }
+
+    // Sends as much of the outbox as the socket takes without blocking; false once the peer is gone.
+    bool flushOutbox(int fd, std::string &outbox)
+    {
+        std::size_t sent = 0;
+        while (sent < outbox.size())
+        {
+            ssize_t n = ::send(fd, outbox.data() + sent, outbox.size() - sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    break;
+                outbox.clear();
+                return false;
+            }
+            sent += static_cast<std::size_t>(n);
+        }
+        outbox.erase(0, sent);
+        return true;
+    }
+
+    void setNonBlocking(int fd)
+    {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    // Appends everything readable without blocking; false once the peer is gone.
+    bool readAvailable(int fd, std::string &inbox)
+    {
+        char chunk[65536];
+        while (true)
+        {
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), MSG_DONTWAIT);
+            if (n > 0)
+            {
+                inbox.append(chunk, static_cast<std::size_t>(n));
+                continue;
+            }
+            if (n == 0)
+                return false;
+            if (errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+    }
+
+    // Takes the next complete frame off the front of the inbox.
+    bool nextFrame(std::string &inbox, char &type, std::string &payload)
+    {
+        if (inbox.size() < FrameHeaderSize)
+            return false;
+        std::uint32_t length = 0;
+        for (int i = 0; i < 4; ++i)
+            length |= static_cast<std::uint32_t>(static_cast<unsigned char>(inbox[1 + i])) << (8 * i);
+        if (length > MaxFramePayload)
+        {
+            // Corrupt stream; drop it rather than buffering forever.
+            inbox.clear();
+            return false;
+        }
+        if (inbox.size() < FrameHeaderSize + length)
+            return false;
+        type = inbox[0];
+        payload.assign(inbox, FrameHeaderSize, length);
+        inbox.erase(0, FrameHeaderSize + length);
+        return true;
+    }
+
+    // Unique per call, also for concurrent calls in one process.
+    std::string uniqueSegmentName()
+    {
+        static std::atomic<std::uint64_t> counter{0};
+        std::random_device random;
+        return "/vrp_ea_" + std::to_string(::getpid()) + "_" + std::to_string(++counter) + "_" + std::to_string(random());
+    }
+
+    bool decodeMigrant(const std::string &payload, Migrant &migrant)
+    {
+        const char *pos = payload.data();
+        return decodeSolution(pos, payload.data() + payload.size(), migrant.routes, migrant.cost);
+    }
+
+    // FNV-1a over the bytes of the values added.
+    struct FingerprintHash
+    {
+        std::uint64_t value = 14695981039346656037ull;
+
+        template <class T>
+        void add(T field)
+        {
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, &field, sizeof(T));
+            for (unsigned char byte : bytes)
+            {
+                value ^= byte;
+                value *= 1099511628211ull;
+            }
+        }
+    };
+
+    // A full matrix may be gigabytes, so only a fixed pseudo-random sample of entries is hashed.
+    void addMatrix(FingerprintHash &hash, const MappedMatrix *matrix)
+    {
+        hash.add(matrix != nullptr);
+        if (matrix == nullptr || matrix->size() == 0)
+            return;
+        hash.add(static_cast<std::uint32_t>(matrix->valueType()));
+        hash.add(matrix->isSymmetric());
+        std::mt19937_64 rng(0x5EEDC0DEULL);
+        for (int k = 0; k < 4096; ++k)
+        {
+            int from = static_cast<int>(rng() % matrix->size());
+            int to = static_cast<int>(rng() % matrix->size());
+            hash.add(matrix->at(from, to));
+        }
+    }
+}
+
+// Shared-memory layout: segment header, then one ring per island, every ring a
+// header followed by SlotsPerRing slots. All parts start on a cache line.
+struct SharedMemoryExchange::SegmentHeader
+{
+    std::uint32_t magic;
+    std::uint32_t numIslands;
+    std::uint32_t slotsPerRing;
+    std::uint32_t slotSize;
+    std::atomic<std::uint32_t> stop;
+};
+
+struct SharedMemoryExchange::RingHeader
+{
+    std::atomic<std::uint64_t> head; ///< Number of solutions published so far.
+};
+
+struct SharedMemoryExchange::SlotHeader
+{
+    std::atomic<std::uint32_t> sequence; ///< Odd while the writer is copying.
+    std::uint32_t size;                  ///< Payload bytes.
+};
+
+SharedMemoryExchange::SharedMemoryExchange(const std::string &name, int numIslands, int island, std::size_t slotSize, bool create)
+    : name(name), owner(create), island(island), slotSize(slotSize)
+{
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Shared-memory rings need lock-free atomics.");
+    if (numIslands <= 0 || island < 0 || island >= numIslands)
+        throw std::invalid_argument("Invalid island index.");
+
+    slotStride = alignUp(sizeof(SlotHeader) + slotSize, CacheLine);
+    ringStride = alignUp(sizeof(RingHeader), CacheLine) + SlotsPerRing * slotStride;
+    mappedSize = alignUp(sizeof(SegmentHeader), CacheLine) + static_cast<std::size_t>(numIslands) * ringStride;
+
+    int fd = create ? ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600) : ::shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open shared memory segment " + name + ": " + std::strerror(errno));
+    if (create && ::ftruncate(fd, static_cast<off_t>(mappedSize)) != 0)
+    {
+        int error = errno;
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        throw std::runtime_error("Cannot size shared memory segment " + name + ": " + std::strerror(error));
+    }
+    void *mapping = ::mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        if (create)
+            ::shm_unlink(name.c_str());
+        throw std::runtime_error("Cannot map shared memory segment " + name + ": " + std::strerror(errno));
+    }
+    base = static_cast<unsigned char *>(mapping);
+
+    if (create)
+    {
+        // A fresh segment is zero-filled, so the rings start empty.
+        header = new (base) SegmentHeader{SegmentMagic, static_cast<std::uint32_t>(numIslands), SlotsPerRing,
+                                          static_cast<std::uint32_t>(slotSize), {0}};
+        for (int r = 0; r < numIslands; ++r)
+        {
+            new (ring(r)) RingHeader{{0}};
+            for (std::uint32_t s = 0; s < SlotsPerRing; ++s)
+                new (slot(r, s)) SlotHeader{{0}, 0};
+        }
+    }
+    else
+    {
+        header = reinterpret_cast<SegmentHeader *>(base);
+        if (header->magic != SegmentMagic || header->numIslands != static_cast<std::uint32_t>(numIslands) ||
+            header->slotSize != slotSize)
+        {
+            ::munmap(base, mappedSize);
+            throw std::runtime_error("Shared memory segment " + name + " has a different layout.");
+        }
+    }
+    readPositions.assign(static_cast<std::size_t>(numIslands), 0);
+}
+
+SharedMemoryExchange::~SharedMemoryExchange()
+{
+    if (base != nullptr)
+        ::munmap(base, mappedSize);
+    if (owner)
+        ::shm_unlink(name.c_str());
+}
+
+SharedMemoryExchange::RingHeader *SharedMemoryExchange::ring(int index) const
+{
+    return reinterpret_cast<RingHeader *>(base + alignUp(sizeof(SegmentHeader), CacheLine) + static_cast<std::size_t>(index) * ringStride);
+}
+
+SharedMemoryExchange::SlotHeader *SharedMemoryExchange::slot(int ringIndex, std::uint64_t position) const
+{
+    unsigned char *slots = reinterpret_cast<unsigned char *>(ring(ringIndex)) + alignUp(sizeof(RingHeader), CacheLine);
+    return reinterpret_cast<SlotHeader *>(slots + (position % SlotsPerRing) * slotStride);
+}
+
+void SharedMemoryExchange::publish(const std::vector<std::vector<int>> &routes, double cost)
+{
+    buffer.clear();
+    encodeSolution(buffer, routes, cost);
+    if (buffer.size() > slotSize)
+        return;
+
+    RingHeader *own = ring(island);
+    std::uint64_t head = own->head.load(std::memory_order_relaxed);
+    SlotHeader *target = slot(island, head);
+    std::uint32_t sequence = target->sequence.load(std::memory_order_relaxed);
+    target->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    target->size = static_cast<std::uint32_t>(buffer.size());
+    std::memcpy(reinterpret_cast<unsigned char *>(target) + sizeof(SlotHeader), buffer.data(), buffer.size());
+    target->sequence.store(sequence + 2, std::memory_order_release);
+    own->head.store(head + 1, std::memory_order_release);
+}
+
+void SharedMemoryExchange::receive(std::vector<Migrant> &migrants)
+{
+    for (int r = 0; r < static_cast<int>(header->numIslands); ++r)
+    {
+        if (r == island)
+            continue;
+        std::uint64_t head = ring(r)->head.load(std::memory_order_acquire);
+        std::uint64_t &position = readPositions[r];
+        if (head - position > SlotsPerRing)
+            position = head - SlotsPerRing;
+        for (; position < head; ++position)
+        {
+            SlotHeader *source = slot(r, position);
+            std::uint32_t before = source->sequence.load(std::memory_order_acquire);
+            if (before & 1u)
+                continue;
+            std::uint32_t size = source->size;
+            if (size > slotSize)
+                continue;
+            buffer.assign(reinterpret_cast<const char *>(source) + sizeof(SlotHeader), size);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (source->sequence.load(std::memory_order_relaxed) != before)
+                continue;
+
+            Migrant migrant;
+            if (decodeMigrant(buffer, migrant))
+                migrants.push_back(std::move(migrant));
+        }
+    }
+}
+
+bool SharedMemoryExchange::stopRequested()
+{
+    return header->stop.load(std::memory_order_acquire) != 0;
+}
+
+void SharedMemoryExchange::requestStop()
+{
+    header->stop.store(1, std::memory_order_release);
+}
+
+std::size_t SharedMemoryExchange::slotSizeFor(const VRP &vrp)
+{
+    // Cost, route count, one length per route and one index per customer, as varints.
+    std::size_t numRoutes = static_cast<std::size_t>(std::max(vrp.getNumVehicles(), 1));
+    return sizeof(double) + 10 + (numRoutes + vrp.getNodes().size()) * 5;
+}
+
+TcpCoordinator::TcpCoordinator(int port, std::uint64_t fingerprint)
+    : fingerprint(fingerprint), bestCost(std::numeric_limits<double>::max())
+{
+    listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0)
+        throw std::runtime_error(std::string("Cannot create socket: ") + std::strerror(errno));
+    int yes = 1;
+    ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(static_cast<std::uint16_t>(port));
+    if (::bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || ::listen(listenFd, 64) != 0)
+    {
+        int error = errno;
+        ::close(listenFd);
+        throw std::runtime_error("Cannot listen on port " + std::to_string(port) + ": " + std::strerror(error));
+    }
+    ::fcntl(listenFd, F_SETFL, ::fcntl(listenFd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+TcpCoordinator::~TcpCoordinator()
+{
+    for (Connection &connection : connections)
+        ::close(connection.fd);
+    if (listenFd >= 0)
+        ::close(listenFd);
+}
+
+void TcpCoordinator::acceptPending()
+{
+    while (true)
+    {
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0)
+            return;
+        int yes = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        setNonBlocking(fd);
+        Connection connection;
+        connection.fd = fd;
+        connections.push_back(std::move(connection));
+    }
+}
+
+std::size_t TcpCoordinator::greetedWorkers() const
+{
+    return static_cast<std::size_t>(std::count_if(connections.begin(), connections.end(), [](const Connection &connection)
+                                                   { return connection.greeted; }));
+}
+
+void TcpCoordinator::pollConnections(int timeoutMs)
+{
+    std::vector<pollfd> fds;
+    fds.push_back({listenFd, POLLIN, 0});
+    for (const Connection &connection : connections)
+        fds.push_back({connection.fd, static_cast<short>(connection.outbox.empty() ? POLLIN : POLLIN | POLLOUT), 0});
+    ::poll(fds.data(), fds.size(), timeoutMs);
+    acceptPending();
+    readConnections(early);
+}
+
+std::size_t TcpCoordinator::waitForWorkers(std::size_t count, int timeoutMs)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (greetedWorkers() < count && std::chrono::steady_clock::now() < deadline)
+        pollConnections(100);
+    return greetedWorkers();
+}
+
+void TcpCoordinator::broadcast(char type, const std::string &payload, int exceptFd)
+{
+    for (Connection &connection : connections)
+    {
+        if (connection.fd == exceptFd || !connection.greeted)
+            continue;
+        // A newer elite supersedes the queued ones, so a slow worker only loses elites.
+        if (type == FrameElite && connection.outbox.size() > MaxOutbox)
+            continue;
+        appendFrame(connection.outbox, type, payload);
+    }
+}
+
+void TcpCoordinator::readConnections(std::vector<Migrant> &migrants)
+{
+    char type;
+    std::string payload;
+    for (std::size_t i = 0; i < connections.size();)
+    {
+        Connection &connection = connections[i];
+        bool open = flushOutbox(connection.fd, connection.outbox) && readAvailable(connection.fd, connection.inbox);
+        while (nextFrame(connection.inbox, type, payload))
+        {
+            if (type == FrameHello)
+            {
+                const char *pos = payload.data();
+                std::uint64_t greeting = 0;
+                if (readVarint(pos, payload.data() + payload.size(), greeting) && greeting == fingerprint)
+                {
+                    connection.greeted = true;
+                }
+                else
+                {
+                    std::cerr << "Rejected island worker with a different instance or configuration." << std::endl;
+                    open = false;
+                    break;
+                }
+            }
+            else if (type == FrameElite && connection.greeted)
+            {
+                Migrant migrant;
+                if (!decodeMigrant(payload, migrant))
+                    continue;
+                // Every improvement of the global best is forwarded to the other workers.
+                if (migrant.cost < bestCost)
+                {
+                    bestCost = migrant.cost;
+                    broadcast(FrameElite, payload, connection.fd);
+                }
+                migrants.push_back(std::move(migrant));
+            }
+        }
+        // Frames queued while reading (forwarded elites) go out right away when the socket takes them.
+        if (open && !flushOutbox(connection.fd, connection.outbox))
+            open = false;
+        if (open)
+        {
+            ++i;
+        }
+        else
+        {
+            ::close(connection.fd);
+            connections.erase(connections.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+    }
+}
+
+void TcpCoordinator::publish(const std::vector<std::vector<int>> &routes, double cost)
+{
+    // Greet the workers that connected meanwhile, so that they get this elite too.
+    acceptPending();
+    readConnections(early);
+    if (cost >= bestCost)
+        return;
+    bestCost = cost;
+    std::string payload;
+    encodeSolution(payload, routes, cost);
+    broadcast(FrameElite, payload, -1);
+    readConnections(early);
+}
+
+void TcpCoordinator::receive(std::vector<Migrant> &migrants)
+{
+    for (Migrant &migrant : early)
+        migrants.push_back(std::move(migrant));
+    early.clear();
+    acceptPending();
+    readConnections(migrants);
+}
+
+void TcpCoordinator::requestStop()
+{
+    broadcast(FrameStop, std::string(), -1);
+    readConnections(early);
+}
+
+void TcpCoordinator::collectFinal(std::vector<Migrant> &migrants, int timeoutMs)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!connections.empty() && std::chrono::steady_clock::now() < deadline)
+        pollConnections(100);
+    for (Migrant &migrant : early)
+        migrants.push_back(std::move(migrant));
+    early.clear();
+}
+
+TcpWorker::TcpWorker(const std::string &host, int port, std::uint64_t fingerprint, int timeoutMs)
+{
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    std::string service = std::to_string(port);
+
+    // The coordinator may not be listening yet, so keep retrying until the deadline.
+    while (fd < 0)
+    {
+        addrinfo *addresses = nullptr;
+        if (::getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses) == 0)
+        {
+            for (addrinfo *address = addresses; address != nullptr && fd < 0; address = address->ai_next)
+            {
+                int candidate = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+                if (candidate < 0)
+                    continue;
+                if (::connect(candidate, address->ai_addr, address->ai_addrlen) == 0)
+                    fd = candidate;
+                else
+                    ::close(candidate);
+            }
+            ::freeaddrinfo(addresses);
+        }
+        if (fd >= 0)
+            break;
+        if (std::chrono::steady_clock::now() >= deadline)
+            throw std::runtime_error("Cannot connect to coordinator " + host + ":" + service + ".");
+        ::usleep(100000);
+    }
+
+    int yes = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+    setNonBlocking(fd);
+    std::string hello;
+    appendVarint(hello, fingerprint);
+    appendFrame(outbox, FrameHello, hello);
+    flushOutbox(fd, outbox);
+}
+
+TcpWorker::~TcpWorker()
+{
+    // Deliver the final elite; the coordinator keeps reading until the workers disconnect.
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!outbox.empty() && std::chrono::steady_clock::now() < deadline)
+    {
+        pollfd pfd{fd, POLLOUT, 0};
+        ::poll(&pfd, 1, 100);
+        if (!flushOutbox(fd, outbox))
+            break;
+    }
+    ::close(fd);
+}
+
+void TcpWorker::publish(const std::vector<std::vector<int>> &routes, double cost)
+{
+    std::string payload;
+    encodeSolution(payload, routes, cost);
+    if (outbox.size() <= MaxOutbox)
+        appendFrame(outbox, FrameElite, payload);
+    if (!flushOutbox(fd, outbox))
+        stopped = true;
+}
+
+void TcpWorker::readFrames()
+{
+    if (!flushOutbox(fd, outbox) || !readAvailable(fd, inbox))
+        stopped = true;
+    char type;
+    std::string payload;
+    while (nextFrame(inbox, type, payload))
+    {
+        if (type == FrameStop)
+        {
+            stopped = true;
+        }
+        else if (type == FrameElite)
+        {
+            Migrant migrant;
+            if (decodeMigrant(payload, migrant))
+                pending.push_back(std::move(migrant));
+        }
+    }
+}
+
+void TcpWorker::receive(std::vector<Migrant> &migrants)
+{
+    readFrames();
+    for (Migrant &migrant : pending)
+        migrants.push_back(std::move(migrant));
+    pending.clear();
+}
+
+bool TcpWorker::stopRequested()
+{
+    if (!stopped)
+        readFrames();
+    return stopped;
+}
+
+namespace
+{
+    // Runs an island; collectFinal (if set) gathers the other islands' final
+    // solutions after the last generation. They are injected like migrants,
+    // so the result is repaired and scored by this island's evaluation.
+    SolveResult runIslandAndCollect(const VRP &vrp, const SolverConfig &config, MigrationChannel &channel, int migrationInterval,
+                                    const CancellationToken *token,
+                                    const std::function<void(std::vector<Migrant> &)> &collectFinal)
+    {
+        if (vrp.getNodes().size() < 2)
+            throw std::invalid_argument("VRP instance has no customers.");
+        if (vrp.getNumVehicles() <= 0)
+            throw std::invalid_argument("VRP instance has no vehicles.");
+
+        using Clock = std::chrono::steady_clock;
+        auto start = Clock::now();
+        auto elapsedMs = [&]
+        { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+        migrationInterval = std::max(migrationInterval, 1);
+
+        GeneticAlgorithm ga(vrp, config.selectionMethod, config.tournamentSize);
+        configureSolver(ga, config);
+        ga.initializePopulation(config.populationSize);
+
+        SolveResult result;
+        SolveStatistics &stats = result.statistics;
+        stats.initialCost = ga.getBestSolutionCost();
+        stats.bestCostHistory.reserve(config.generations);
+
+        std::vector<Migrant> migrants;
+        for (int gen = 0; gen < config.generations; ++gen)
+        {
+            if (token != nullptr && token->isCancelled())
+            {
+                stats.cancelled = true;
+                break;
+            }
+            if (config.timeLimitSeconds > 0.0 && elapsedMs() >= config.timeLimitSeconds * 1000.0)
+            {
+                stats.timedOut = true;
+                break;
+            }
+            if (channel.stopRequested())
+            {
+                stats.cancelled = true;
+                break;
+            }
+            ga.run(1);
+            stats.generations++;
+            stats.bestCostHistory.push_back(ga.getBestSolutionCost());
+
+            if (stats.generations % migrationInterval == 0)
+            {
+                channel.publish(ga.getBestSolution(), ga.getBestSolutionCost());
+                migrants.clear();
+                channel.receive(migrants);
+                for (Migrant &migrant : migrants)
+                    ga.injectSolution(std::move(migrant.routes));
+            }
+        }
+        channel.publish(ga.getBestSolution(), ga.getBestSolutionCost());
+        if (collectFinal)
+        {
+            migrants.clear();
+            collectFinal(migrants);
+            for (Migrant &migrant : migrants)
+                ga.injectSolution(std::move(migrant.routes));
+        }
+
+        result.routes = ga.getBestSolution();
+        result.cost = ga.getBestSolutionCost();
+        stats.elapsedMs = elapsedMs();
+        stats.operators = ga.getOperatorScheduler().getStats();
+        result.population = ga.getPopulation();
+        return result;
+    }
+}
+
+SolveResult runIsland(const VRP &vrp, const SolverConfig &config, MigrationChannel &channel,
+                      int migrationInterval, const CancellationToken *token)
+{
+    return runIslandAndCollect(vrp, config, channel, migrationInterval, token, {});
+}
+
+std::uint64_t islandFingerprint(const VRP &vrp, const SolverConfig &config)
+{
+    FingerprintHash hash;
+    hash.add(static_cast<std::uint64_t>(vrp.getNodes().size()));
+    for (const Node &node : vrp.getNodes())
+    {
+        hash.add(node.x);
+        hash.add(node.y);
+        hash.add(node.demand);
+        hash.add(node.readyTime);
+        hash.add(node.dueDate);
+        hash.add(node.serviceTime);
+    }
+    hash.add(vrp.getNumVehicles());
+    hash.add(vrp.getVehicleCapacity());
+    hash.add(static_cast<int>(config.distanceType));
+    hash.add(static_cast<int>(config.constraintType));
+    hash.add(config.penalties.capacity);
+    hash.add(config.penalties.lateness);
+    addMatrix(hash, vrp.getDistanceFile());
+    addMatrix(hash, vrp.getDurationFile());
+    return hash.value;
+}
+
+SolveResult solveLocalIslands(const VRP &vrp, const SolverConfig &config, int numIslands,
+                              const std::vector<std::string> &workerCommand, int migrationInterval,
+                              const CancellationToken *token)
+{
+    if (numIslands <= 1)
+        return solve(vrp, config, token);
+    if (workerCommand.empty())
+        throw std::invalid_argument("Island workers need a command to start.");
+
+    std::string name = uniqueSegmentName();
+    std::uint64_t fingerprint = islandFingerprint(vrp, config);
+    SharedMemoryExchange coordinator(name, numIslands, 0, SharedMemoryExchange::slotSizeFor(vrp), true);
+
+    std::vector<pid_t> workers;
+    auto stopWorkers = [&]
+    {
+        coordinator.requestStop();
+        for (pid_t worker : workers)
+            ::waitpid(worker, nullptr, 0);
+        workers.clear();
+    };
+
+    // posix_spawn execs right away, so nothing of this (possibly threaded) process runs in the child.
+    // The workers' standard output would interleave with the caller's; only stderr is kept.
+    posix_spawn_file_actions_t actions;
+    ::posix_spawn_file_actions_init(&actions);
+    ::posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    for (int island = 1; island < numIslands; ++island)
+    {
+        unsigned int seed = config.seed != 0 ? config.seed + static_cast<unsigned int>(island) : 0u;
+        std::vector<std::string> arguments = workerCommand;
+        arguments.push_back(SharedMemoryIslandOption + name + ":" + std::to_string(island) + ":" + std::to_string(numIslands) +
+                            ":" + std::to_string(seed) + ":" + std::to_string(std::max(migrationInterval, 1)) + ":" +
+                            std::to_string(fingerprint));
+        std::vector<char *> argv;
+        for (std::string &argument : arguments)
+            argv.push_back(argument.data());
+        argv.push_back(nullptr);
+
+        pid_t pid = 0;
+        int error = ::posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+        if (error != 0)
+        {
+            ::posix_spawn_file_actions_destroy(&actions);
+            stopWorkers();
+            throw std::runtime_error("Cannot start island process " + arguments[0] + ": " + std::strerror(error));
+        }
+        workers.push_back(pid);
+    }
+    ::posix_spawn_file_actions_destroy(&actions);
+
+    try
+    {
+        // The last solution in every ring is the final best of that island.
+        return runIslandAndCollect(vrp, config, coordinator, migrationInterval, token, [&](std::vector<Migrant> &finals)
+                                   {
+                                       stopWorkers();
+                                       coordinator.receive(finals);
+                                   });
+    }
+    catch (...)
+    {
+        stopWorkers();
+        throw;
+    }
+}
+
+SolveResult runSharedMemoryWorker(const VRP &vrp, const SolverConfig &config, const std::string &spec,
+                                  const CancellationToken *token)
+{
+    // NAME:ISLAND:COUNT:SEED:INTERVAL:FINGERPRINT, as written by solveLocalIslands().
+    std::vector<std::string> fields;
+    std::size_t start = 0;
+    while (true)
+    {
+        std::size_t colon = spec.find(':', start);
+        fields.push_back(spec.substr(start, colon - start));
+        if (colon == std::string::npos)
+            break;
+        start = colon + 1;
+    }
+    if (fields.size() != 6 || fields[0].empty())
+        throw std::invalid_argument("Malformed island specification: " + spec);
+
+    int island = std::stoi(fields[1]);
+    int numIslands = std::stoi(fields[2]);
+    if (std::stoull(fields[5]) != islandFingerprint(vrp, config))
+        throw std::invalid_argument("Island worker has a different instance or configuration than the coordinator.");
+    SolverConfig islandConfig = config;
+    islandConfig.seed = static_cast<unsigned int>(std::stoul(fields[3]));
+    SharedMemoryExchange exchange(fields[0], numIslands, island, SharedMemoryExchange::slotSizeFor(vrp), false);
+    return runIsland(vrp, islandConfig, exchange, std::stoi(fields[4]), token);
+}
+
+SolveResult runTcpCoordinator(const VRP &vrp, const SolverConfig &config, int port, int numWorkers,
+                              int migrationInterval, const CancellationToken *token)
+{
+    TcpCoordinator coordinator(port, islandFingerprint(vrp, config));
+    std::size_t connected = coordinator.waitForWorkers(static_cast<std::size_t>(std::max(numWorkers, 0)), 30000);
+    if (connected < static_cast<std::size_t>(std::max(numWorkers, 0)))
+        std::cerr << "Only " << connected << " of " << numWorkers << " island workers connected." << std::endl;
+
+    return runIslandAndCollect(vrp, config, coordinator, migrationInterval, token, [&](std::vector<Migrant> &finals)
+                               {
+                                   coordinator.requestStop();
+                                   coordinator.collectFinal(finals, 10000);
+                               });
+}
+
+SolveResult runTcpWorker(const VRP &vrp, const SolverConfig &config, const std::string &host, int port,
+                         int migrationInterval, const CancellationToken *token)
+{
+    TcpWorker worker(host, port, islandFingerprint(vrp, config));
+    return runIsland(vrp, config, worker, migrationInterval, token);
+}
@@ -1,14 +1,96 @@
 #include "vrp.hpp"
-#include "genetic_algorithm.hpp"
+#include "solver.hpp"
+#include "result_sink.hpp"
+#include "island.hpp"
 #include <iostream>
 #include <vector>
 #include <numeric> // For std::accumulate
 #include <algorithm>
-#include <fstream>
+#include <cstdlib>
 #include <filesystem>
+#include <limits>
+#include <memory>
+#include <string>
 
-int main()
+int main(int argc, char *argv[])
 {
+    // Command line options: --quiet, --format=text|jsonl|binary|sol,
+    // --distance=double|float|scaled|rounded, --constraints=none|capacity|tw,
+    // --survivors=elitist|diversity, --islands=N, --listen=PORT, --workers=K,
+    // --connect=HOST:PORT, --migration=GENERATIONS, --distance-matrix=PATH,
+    // --duration-matrix=PATH, --route-pool
+    bool quiet = false;
+    std::string distanceMatrixPath;
+    std::string durationMatrixPath;
+    int islands = 1;
+    int listenPort = 0;
+    int numWorkers = 0;
+    std::string connectTo;
+    std::string islandSpec;
+    std::vector<std::string> workerCommand{argv[0]};
+    int migrationInterval = 10;
+    std::string format = "text";
+    SolverConfig config;
+    config.populationSize = 50;
+    config.generations = 100;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        // Island workers rebuild the same instance and configuration from the same options.
+        if (arg.rfind("--islands=", 0) != 0 && arg.rfind(SharedMemoryIslandOption, 0) != 0)
+            workerCommand.push_back(arg);
+        if (arg == "--quiet")
+            quiet = true;
+        else if (arg.rfind("--format=", 0) == 0)
+            format = arg.substr(9);
+        else if (arg == "--distance=double")
+            config.distanceType = DistanceType::Double;
+        else if (arg == "--distance=float")
+            config.distanceType = DistanceType::Float;
+        else if (arg == "--distance=scaled")
+            config.distanceType = DistanceType::ScaledInteger;
+        else if (arg == "--distance=rounded")
+            config.distanceType = DistanceType::RoundedInteger;
+        else if (arg == "--constraints=none")
+            config.constraintType = ConstraintType::Unconstrained;
+        else if (arg == "--constraints=capacity")
+            config.constraintType = ConstraintType::Capacity;
+        else if (arg == "--constraints=tw")
+            config.constraintType = ConstraintType::TimeWindows;
+        else if (arg == "--survivors=elitist")
+            config.survivorSelection = SurvivorSelection::Elitist;
+        else if (arg == "--survivors=diversity")
+            config.survivorSelection = SurvivorSelection::BiasedFitness;
+        else if (arg == "--route-pool")
+            config.routePool = true;
+        else if (arg.rfind("--distance-matrix=", 0) == 0)
+            distanceMatrixPath = arg.substr(18);
+        else if (arg.rfind("--duration-matrix=", 0) == 0)
+            durationMatrixPath = arg.substr(18);
+        else if (arg.rfind("--islands=", 0) == 0)
+            islands = std::max(1, std::atoi(arg.c_str() + 10));
+        else if (arg.rfind("--listen=", 0) == 0)
+            listenPort = std::atoi(arg.c_str() + 9);
+        else if (arg.rfind("--workers=", 0) == 0)
+            numWorkers = std::max(0, std::atoi(arg.c_str() + 10));
+        else if (arg.rfind("--connect=", 0) == 0)
+            connectTo = arg.substr(10);
+        else if (arg.rfind(SharedMemoryIslandOption, 0) == 0)
+            islandSpec = arg.substr(sizeof(SharedMemoryIslandOption) - 1);
+        else if (arg.rfind("--migration=", 0) == 0)
+            migrationInterval = std::max(1, std::atoi(arg.c_str() + 12));
+        else
+        {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            std::cerr << "Usage: " << argv[0] << " [--quiet] [--format=text|jsonl|binary|sol]"
+                      << " [--distance=double|float|scaled|rounded] [--constraints=none|capacity|tw]"
+                      << " [--survivors=elitist|diversity] [--islands=N | --listen=PORT --workers=K | --connect=HOST:PORT]"
+                      << " [--migration=GENERATIONS] [--distance-matrix=PATH] [--duration-matrix=PATH]"
+                      << " [--route-pool]" << std::endl;
+            return 1;
+        }
+    }
+
     VRP vrp;
     vrp.loadData("data/C101.txt");
 
@@ -18,89 +100,133 @@ int main()
         return 1;
     }
 
-    // Prepare output directory and file for results
-    std::filesystem::create_directories("output");
-    std::ofstream resultsFile("output/results.csv");
-    resultsFile << "run,cost\n";
-
-    const int runs = 10;         // Number of runs
-    std::vector<double> results; // Store the results of each run
-    const int runs = 10;
-    std::vector<double> results;
-    double bestCost = std::numeric_limits<double>::max();
-    std::vector<std::vector<int>> bestSolutionOverall;
+    try
+    {
+        if (!distanceMatrixPath.empty())
+            vrp.loadDistanceMatrix(distanceMatrixPath);
+        if (!durationMatrixPath.empty())
+            vrp.loadDurationMatrix(durationMatrixPath);
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
 
-    for (int i = 0; i < runs; ++i)
+    // A local island worker reports through shared memory only.
+    if (!islandSpec.empty())
     {
-        GeneticAlgorithm ga(vrp);
-        ga.initializePopulation(50);
-        ga.run(100);
+        try
+        {
+            runSharedMemoryWorker(vrp, config, islandSpec);
+        }
+        catch (const std::exception &error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
 
-        double cost = ga.getBestSolutionCost();
-        results.push_back(cost);
+    // A TCP worker only reports its own best; the coordinator writes the results.
+    if (!connectTo.empty())
+    {
+        std::size_t colon = connectTo.rfind(':');
+        if (colon == std::string::npos)
+        {
+            std::cerr << "Expected --connect=HOST:PORT" << std::endl;
+            return 1;
+        }
+        try
+        {
+            SolveResult solved = runTcpWorker(vrp, config, connectTo.substr(0, colon),
+                                              std::atoi(connectTo.c_str() + colon + 1), migrationInterval);
+            std::cout << "Worker best cost: " << solved.cost << std::endl;
+        }
+        catch (const std::exception &error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
 
-        resultsFile << (i + 1) << "," << cost << "\n";
+    // Prepare output directory and the result sinks
+    std::filesystem::create_directories("output");
+    auto fileSinks = std::make_unique<MultiResultSink>();
+    fileSinks->add(std::make_unique<CsvResultSink>("output/results.csv"));
+    fileSinks->add(std::make_unique<OperatorStatsSink>("output"));
+    if (format == "text")
+        fileSinks->add(std::make_unique<RouteFilesSink>("output"));
+    else if (format == "jsonl")
+        fileSinks->add(std::make_unique<JsonLinesResultSink>("output/results.jsonl"));
+    else if (format == "binary")
+        fileSinks->add(std::make_unique<BinaryResultSink>("output/results.bin"));
+    else if (format == "sol")
+        fileSinks->add(std::make_unique<SolomonResultSink>("output", vrp));
+    else
+    {
+        std::cerr << "Unknown output format: " << format << std::endl;
+        return 1;
+    }
+    if (quiet)
+        fileSinks->add(std::make_unique<QuietResultSink>(std::cout));
+    else
+        fileSinks->add(std::make_unique<TextResultSink>(std::cout));
+    AsyncResultSink sink(std::move(fileSinks));
 
-        std::cout << "Run #" << (i + 1) << " cost: " << cost << std::endl;
-        std::cout << "Best solution (routes):" << std::endl;
-        auto bestSolution = ga.getBestSolution();
+    // The runs share one route pool, so later runs can recombine earlier routes.
+    if (config.routePool)
+    {
+        config.sharedRoutePool = std::make_shared<RoutePool>(vrp.getNodes().size());
+        if (!quiet)
+            std::cerr << "route pool: shared across runs" << std::endl;
+    }
 
-        std::ofstream routeFile("output/run_" + std::to_string(i + 1) + "_routes.txt");
+    // An island run is a single cooperative solve.
+    bool islandMode = islands > 1 || listenPort > 0;
+    const int runs = islandMode ? 1 : 10; // Number of runs
+    std::vector<double> results; // Store the results of each run
+    RunSummary summary;
+    summary.runs = runs;
+    summary.bestCost = std::numeric_limits<double>::max();
 
-        for (size_t vehicle = 0; vehicle < bestSolution.size(); ++vehicle)
+    for (int i = 0; i < runs; ++i)
+    {
+        SolveResult solved;
+        try
         {
-            const auto &route = bestSolution[vehicle];
-            if (!route.empty())
-            {
-                std::cout << "Vehicle " << (vehicle + 1) << " route: ";
-                routeFile << "Vehicle " << (vehicle + 1) << ":";
-                for (int node : route)
-                {
-                    std::cout << node << " ";
-                    routeFile << ' ' << node;
-                }
-                std::cout << std::endl;
-                routeFile << "\n";
-            }
+            if (listenPort > 0)
+                solved = runTcpCoordinator(vrp, config, listenPort, numWorkers, migrationInterval);
+            else if (islands > 1)
+                solved = solveLocalIslands(vrp, config, islands, workerCommand, migrationInterval);
             else
-            {
-                std::cout << "Vehicle " << (vehicle + 1) << " has no assigned route." << std::endl;
-                routeFile << "Vehicle " << (vehicle + 1) << ":" << "\n";
-            }
-        if (cost < bestCost)
-        {
-            bestCost = cost;
-            bestSolutionOverall = ga.getBestSolution();
+                solved = solve(vrp, config);
         }
-    }
-
-    std::cout << "Best solution (routes):" << std::endl;
-    for (size_t vehicle = 0; vehicle < bestSolutionOverall.size(); ++vehicle)
-    {
-        const auto &route = bestSolutionOverall[vehicle];
-        if (!route.empty())
+        catch (const std::exception &error)
         {
-            std::cout << "Vehicle " << (vehicle + 1) << " route: ";
-            for (int node : route)
-            {
-                std::cout << node << " ";
-            }
-            std::cout << std::endl;
+            std::cerr << error.what() << std::endl;
+            return 1;
         }
-        else
+
+        RunResult result;
+        result.run = i + 1;
+        result.cost = solved.cost;
+        result.routes = std::move(solved.routes);
+        result.operators = solved.statistics.operators;
+        results.push_back(result.cost);
+
+        if (result.cost < summary.bestCost)
         {
-            // std::cout << "Vehicle " << (vehicle + 1) << " has no assigned route." << std::endl;
+            summary.bestCost = result.cost;
+            summary.routes = result.routes;
         }
-        routeFile.close();
+        sink.writeRun(result);
     }
 
-    double averageCost = std::accumulate(results.begin(), results.end(), 0.0) / runs;
-    std::cout << "Average cost over " << runs << " runs: " << averageCost << std::endl;
-    std::cout << "Best cost over " << runs << " runs: " << bestCost << std::endl;
-
-    resultsFile << "average," << averageCost << "\n";
-    resultsFile << "best," << bestCost << "\n";
-    resultsFile.close();
+    summary.averageCost = std::accumulate(results.begin(), results.end(), 0.0) / runs;
+    sink.writeSummary(summary);
+    sink.flush();
 
     return 0;
 }
@@ -0,0 +1,117 @@
+#include "mapped_matrix.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr char Magic[4] = {'V', 'R', 'P', 'M'};
+    constexpr std::uint32_t Version = 1;
+    constexpr std::size_t HeaderSize = 32;
+
+    struct FileHeader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t valueType;
+        std::uint32_t flags;
+        std::uint64_t numNodes;
+        std::uint64_t reserved;
+    };
+    static_assert(sizeof(FileHeader) == HeaderSize, "Matrix file header must be 32 bytes.");
+}
+
+MappedMatrix::MappedMatrix(const std::string &path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open matrix file " + path + ": " + std::strerror(errno));
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < HeaderSize)
+    {
+        ::close(fd);
+        throw std::runtime_error("Matrix file " + path + " is too short.");
+    }
+    mappedSize = static_cast<std::size_t>(info.st_size);
+    mapping = ::mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        mapping = nullptr;
+        throw std::runtime_error("Cannot map matrix file " + path + ": " + std::strerror(errno));
+    }
+
+    FileHeader header;
+    std::memcpy(&header, mapping, HeaderSize);
+    std::size_t valueSize = header.valueType == static_cast<std::uint32_t>(MatrixValueType::Float32) ? sizeof(float)
+                            : header.valueType == static_cast<std::uint32_t>(MatrixValueType::Float64) ? sizeof(double)
+                                                                                                        : 0;
+    std::string error;
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+        error = "is not a matrix file";
+    else if (header.version != Version)
+        error = "has unsupported version " + std::to_string(header.version);
+    else if (valueSize == 0)
+        error = "has unknown value type " + std::to_string(header.valueType);
+    else if (header.numNodes == 0 || header.numNodes > (mappedSize - HeaderSize) / valueSize / header.numNodes)
+        error = "is smaller than its " + std::to_string(header.numNodes) + " x " + std::to_string(header.numNodes) + " entries";
+    if (!error.empty())
+    {
+        ::munmap(mapping, mappedSize);
+        mapping = nullptr;
+        throw std::runtime_error("Matrix file " + path + " " + error + ".");
+    }
+
+    n = static_cast<std::size_t>(header.numNodes);
+    type = static_cast<MatrixValueType>(header.valueType);
+    symmetric = (header.flags & SymmetricFlag) != 0;
+    const unsigned char *values = static_cast<const unsigned char *>(mapping) + HeaderSize;
+    if (type == MatrixValueType::Float32)
+        floats = reinterpret_cast<const float *>(values);
+    else
+        doubles = reinterpret_cast<const double *>(values);
+
+    // Rows are visited in route order rather than sequentially.
+    ::madvise(mapping, mappedSize, MADV_RANDOM);
+}
+
+MappedMatrix::~MappedMatrix()
+{
+    if (mapping != nullptr)
+        ::munmap(mapping, mappedSize);
+}
+
+void MappedMatrix::write(const std::string &path, std::size_t n, const std::vector<double> &values,
+                         MatrixValueType type, bool symmetric)
+{
+    if (values.size() != n * n)
+        throw std::invalid_argument("Matrix needs n * n values.");
+
+    FileHeader header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.valueType = static_cast<std::uint32_t>(type);
+    header.flags = symmetric ? SymmetricFlag : 0u;
+    header.numNodes = n;
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+        throw std::runtime_error("Cannot write matrix file " + path + ".");
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if (type == MatrixValueType::Float32)
+    {
+        std::vector<float> converted(values.begin(), values.end());
+        out.write(reinterpret_cast<const char *>(converted.data()), static_cast<std::streamsize>(converted.size() * sizeof(float)));
+    }
+    else
+    {
+        out.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(double)));
+    }
+    if (!out)
+        throw std::runtime_error("Cannot write matrix file " + path + ".");
+}
@@ -0,0 +1,96 @@
+#include "operator_scheduler.hpp"
+#include <algorithm>
+
+OperatorScheduler::OperatorScheduler()
+    : baseRates{0.85, 0.1, 0.1, 0.1, 0.5}
+{
+    const char *names[NumOperators] = {"crossover", "swap_mutation", "ruin_recreate", "two_opt", "elite_two_opt"};
+    for (std::size_t i = 0; i < NumOperators; ++i)
+    {
+        stats[i].name = names[i];
+        stats[i].rate = baseRates[i];
+    }
+}
+
+void OperatorScheduler::setAdaptive(bool enabled)
+{
+    adaptive = enabled;
+    if (!adaptive)
+    {
+        for (std::size_t i = 0; i < NumOperators; ++i)
+        {
+            stats[i].weight = 1.0;
+            stats[i].rate = baseRates[i];
+        }
+    }
+}
+
+void OperatorScheduler::setBaseRate(Operator op, double rate)
+{
+    baseRates[index(op)] = std::clamp(rate, 0.0, 1.0);
+    stats[index(op)].rate = baseRates[index(op)];
+}
+
+void OperatorScheduler::record(Operator op, double improvement, double elapsedMs)
+{
+    std::size_t i = index(op);
+    double gain = std::max(0.0, improvement);
+    stats[i].calls++;
+    stats[i].totalMs += elapsedMs;
+    stats[i].totalImprovement += gain;
+    segmentMs[i] += elapsedMs;
+    segmentImprovement[i] += gain;
+}
+
+void OperatorScheduler::endSegment()
+{
+    if (adaptive)
+    {
+        std::array<double, NumOperators> score{};
+        double bestScore = 0.0;
+        for (std::size_t i = 0; i < NumOperators; ++i)
+        {
+            if (segmentMs[i] > 0.0)
+                score[i] = segmentImprovement[i] / segmentMs[i];
+            bestScore = std::max(bestScore, score[i]);
+        }
+
+        double weightSum = 0.0;
+        std::size_t enabled = 0;
+        for (std::size_t i = 0; i < NumOperators; ++i)
+        {
+            if (baseRates[i] <= 0.0)
+                continue;
+            // Operators that were not applied in this segment keep their weight.
+            if (segmentMs[i] > 0.0)
+            {
+                double normalized = bestScore > 0.0 ? score[i] / bestScore : 0.0;
+                stats[i].weight = std::max(minWeight, (1.0 - reaction) * stats[i].weight + reaction * normalized);
+            }
+            weightSum += stats[i].weight;
+            ++enabled;
+        }
+
+        double meanWeight = enabled > 0 ? weightSum / enabled : 0.0;
+        for (std::size_t i = 0; i < NumOperators; ++i)
+        {
+            if (baseRates[i] <= 0.0)
+                continue; // Disabled operators stay disabled.
+            double scaled = meanWeight > 0.0 ? baseRates[i] * stats[i].weight / meanWeight : baseRates[i];
+            stats[i].rate = std::clamp(scaled, minRate, maxRate);
+        }
+    }
+
+    segmentMs.fill(0.0);
+    segmentImprovement.fill(0.0);
+}
+
+void OperatorScheduler::writeCsv(std::ostream &out, const std::array<OperatorStats, NumOperators> &stats)
+{
+    out << "operator,calls,total_ms,total_improvement,improvement_per_ms,weight,rate\n";
+    for (const auto &s : stats)
+    {
+        out << s.name << ',' << s.calls << ',' << s.totalMs << ',' << s.totalImprovement << ','
+            << s.improvementPerMs() << ',' << s.weight << ',' << s.rate << '\n';
+    }
+}
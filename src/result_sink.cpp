@@ -0,0 +1,458 @@
+#include "result_sink.hpp"
+#include "utils.hpp"
+#include <cstdio>
+#include <iostream>
+
+BufferedOutput::BufferedOutput(std::ostream &out, std::size_t capacity)
+    : out(&out), capacity(capacity)
+{
+    buffer.reserve(capacity);
+}
+
+BufferedOutput::BufferedOutput(const std::string &filename, bool binary, std::size_t capacity)
+    : name(filename),
+      file(filename, binary ? std::ios::out | std::ios::trunc | std::ios::binary : std::ios::out | std::ios::trunc),
+      out(&file), capacity(capacity)
+{
+    if (!file)
+    {
+        std::cerr << "Error opening output file: " << filename << std::endl;
+        out = nullptr;
+    }
+    buffer.reserve(capacity);
+}
+
+BufferedOutput::~BufferedOutput()
+{
+    flush();
+}
+
+void BufferedOutput::write(const std::string &data)
+{
+    buffer += data;
+    flushIfFull();
+}
+
+void BufferedOutput::writeNumber(double value)
+{
+    char text[32];
+    int length = std::snprintf(text, sizeof(text), "%g", value);
+    buffer.append(text, length);
+    flushIfFull();
+}
+
+void BufferedOutput::writeExactNumber(double value)
+{
+    char text[32];
+    int length = std::snprintf(text, sizeof(text), "%.17g", value);
+    buffer.append(text, length);
+    flushIfFull();
+}
+
+void BufferedOutput::writeInt(long long value)
+{
+    char text[24];
+    int length = std::snprintf(text, sizeof(text), "%lld", value);
+    buffer.append(text, length);
+    flushIfFull();
+}
+
+void BufferedOutput::put(char c)
+{
+    buffer.push_back(c);
+    flushIfFull();
+}
+
+void BufferedOutput::flush()
+{
+    writeBuffer();
+    if (out != nullptr)
+    {
+        out->flush();
+        if (!*out)
+        {
+            std::cerr << "Error writing output file: " << (name.empty() ? "<stream>" : name) << std::endl;
+            out = nullptr;
+        }
+    }
+}
+
+void BufferedOutput::flushIfFull()
+{
+    if (buffer.size() >= capacity)
+        writeBuffer();
+}
+
+void BufferedOutput::writeBuffer()
+{
+    if (out != nullptr && !buffer.empty())
+    {
+        out->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!*out)
+        {
+            std::cerr << "Error writing output file: " << (name.empty() ? "<stream>" : name) << std::endl;
+            out = nullptr;
+        }
+    }
+    buffer.clear();
+}
+
+TextResultSink::TextResultSink(std::ostream &out, bool printRoutes)
+    : output(out), printRoutes(printRoutes)
+{
+}
+
+void TextResultSink::writeRun(const RunResult &result)
+{
+    output.write("Run #");
+    output.writeInt(result.run);
+    output.write(" cost: ");
+    output.writeNumber(result.cost);
+    output.put('\n');
+    if (printRoutes)
+        writeRoutes(result.routes);
+}
+
+void TextResultSink::writeSummary(const RunSummary &summary)
+{
+    output.write("Best solution (routes):\n");
+    writeRoutes(summary.routes);
+    output.write("Average cost over ");
+    output.writeInt(summary.runs);
+    output.write(" runs: ");
+    output.writeNumber(summary.averageCost);
+    output.write("\nBest cost over ");
+    output.writeInt(summary.runs);
+    output.write(" runs: ");
+    output.writeNumber(summary.bestCost);
+    output.put('\n');
+}
+
+void TextResultSink::flush()
+{
+    output.flush();
+}
+
+void TextResultSink::writeRoutes(const std::vector<std::vector<int>> &routes)
+{
+    for (std::size_t vehicle = 0; vehicle < routes.size(); ++vehicle)
+    {
+        if (routes[vehicle].empty())
+            continue;
+        output.write("Vehicle ");
+        output.writeInt(static_cast<long long>(vehicle + 1));
+        output.write(" route: ");
+        for (int node : routes[vehicle])
+        {
+            output.writeInt(node);
+            output.put(' ');
+        }
+        output.put('\n');
+    }
+}
+
+QuietResultSink::QuietResultSink(std::ostream &out)
+    : output(out)
+{
+}
+
+void QuietResultSink::writeSummary(const RunSummary &summary)
+{
+    output.writeNumber(summary.bestCost);
+    output.put('\n');
+}
+
+void QuietResultSink::flush()
+{
+    output.flush();
+}
+
+OperatorStatsSink::OperatorStatsSink(const std::string &directory)
+    : directory(directory)
+{
+}
+
+void OperatorStatsSink::writeRun(const RunResult &result)
+{
+    BufferedOutput output(directory + "/run_" + std::to_string(result.run) + "_operators.csv", false);
+    output.write("operator,calls,total_ms,total_improvement,improvement_per_ms,weight,rate\n");
+    for (const OperatorStats &stats : result.operators)
+    {
+        output.write(stats.name);
+        output.put(',');
+        output.writeInt(stats.calls);
+        output.put(',');
+        output.writeNumber(stats.totalMs);
+        output.put(',');
+        output.writeNumber(stats.totalImprovement);
+        output.put(',');
+        output.writeNumber(stats.improvementPerMs());
+        output.put(',');
+        output.writeNumber(stats.weight);
+        output.put(',');
+        output.writeNumber(stats.rate);
+        output.put('\n');
+    }
+}
+
+CsvResultSink::CsvResultSink(const std::string &filename)
+    : output(filename, false)
+{
+    output.write("run,cost\n");
+}
+
+void CsvResultSink::writeRun(const RunResult &result)
+{
+    output.writeInt(result.run);
+    output.put(',');
+    output.writeNumber(result.cost);
+    output.put('\n');
+}
+
+void CsvResultSink::writeSummary(const RunSummary &summary)
+{
+    output.write("average,");
+    output.writeNumber(summary.averageCost);
+    output.write("\nbest,");
+    output.writeNumber(summary.bestCost);
+    output.put('\n');
+}
+
+void CsvResultSink::flush()
+{
+    output.flush();
+}
+
+RouteFilesSink::RouteFilesSink(const std::string &directory)
+    : directory(directory)
+{
+}
+
+void RouteFilesSink::writeRun(const RunResult &result)
+{
+    BufferedOutput output(directory + "/run_" + std::to_string(result.run) + "_routes.txt", false);
+    for (std::size_t vehicle = 0; vehicle < result.routes.size(); ++vehicle)
+    {
+        output.write("Vehicle ");
+        output.writeInt(static_cast<long long>(vehicle + 1));
+        output.put(':');
+        for (int node : result.routes[vehicle])
+        {
+            output.put(' ');
+            output.writeInt(node);
+        }
+        output.put('\n');
+    }
+}
+
+JsonLinesResultSink::JsonLinesResultSink(const std::string &filename)
+    : output(filename, false)
+{
+}
+
+void JsonLinesResultSink::writeRun(const RunResult &result)
+{
+    output.write("{\"run\":");
+    output.writeInt(result.run);
+    output.write(",\"cost\":");
+    output.writeExactNumber(result.cost);
+    output.write(",\"routes\":");
+    writeRoutes(result.routes);
+    output.write("}\n");
+}
+
+void JsonLinesResultSink::writeSummary(const RunSummary &summary)
+{
+    output.write("{\"summary\":{\"runs\":");
+    output.writeInt(summary.runs);
+    output.write(",\"average_cost\":");
+    output.writeExactNumber(summary.averageCost);
+    output.write(",\"best_cost\":");
+    output.writeExactNumber(summary.bestCost);
+    output.write(",\"routes\":");
+    writeRoutes(summary.routes);
+    output.write("}}\n");
+}
+
+void JsonLinesResultSink::flush()
+{
+    output.flush();
+}
+
+void JsonLinesResultSink::writeRoutes(const std::vector<std::vector<int>> &routes)
+{
+    output.put('[');
+    for (std::size_t r = 0; r < routes.size(); ++r)
+    {
+        if (r > 0)
+            output.put(',');
+        output.put('[');
+        for (std::size_t i = 0; i < routes[r].size(); ++i)
+        {
+            if (i > 0)
+                output.put(',');
+            output.writeInt(routes[r][i]);
+        }
+        output.put(']');
+    }
+    output.put(']');
+}
+
+BinaryResultSink::BinaryResultSink(const std::string &filename)
+    : output(filename, true)
+{
+    output.write(std::string("VRPS\x01", 5));
+}
+
+void BinaryResultSink::writeRun(const RunResult &result)
+{
+    record.clear();
+    appendVarint(record, static_cast<std::uint64_t>(result.run));
+    encodeSolution(record, result.routes, result.cost);
+    output.write(record);
+}
+
+void BinaryResultSink::flush()
+{
+    output.flush();
+}
+
+SolomonResultSink::SolomonResultSink(const std::string &directory, const VRP &vrp)
+    : directory(directory), vrp(vrp)
+{
+}
+
+void SolomonResultSink::writeRun(const RunResult &result)
+{
+    writeSolution(directory + "/run_" + std::to_string(result.run) + ".sol", result.routes, result.cost);
+}
+
+void SolomonResultSink::writeSummary(const RunSummary &summary)
+{
+    writeSolution(directory + "/best.sol", summary.routes, summary.bestCost);
+}
+
+void SolomonResultSink::writeSolution(const std::string &filename, const std::vector<std::vector<int>> &routes, double cost) const
+{
+    const std::vector<Node> &nodes = vrp.getNodes();
+    BufferedOutput output(filename, false);
+    int routeNumber = 0;
+    for (const auto &route : routes)
+    {
+        if (route.empty())
+            continue;
+        output.write("Route #");
+        output.writeInt(++routeNumber);
+        output.put(':');
+        for (int node : route)
+        {
+            output.put(' ');
+            output.writeInt(nodes[node].id);
+        }
+        output.write(" \n");
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), "Cost %.1f\n", cost);
+    output.write(text);
+}
+
+void MultiResultSink::add(std::unique_ptr<ResultSink> sink)
+{
+    sinks.push_back(std::move(sink));
+}
+
+void MultiResultSink::writeRun(const RunResult &result)
+{
+    for (auto &sink : sinks)
+        sink->writeRun(result);
+}
+
+void MultiResultSink::writeSummary(const RunSummary &summary)
+{
+    for (auto &sink : sinks)
+        sink->writeSummary(summary);
+}
+
+void MultiResultSink::flush()
+{
+    for (auto &sink : sinks)
+        sink->flush();
+}
+
+AsyncResultSink::AsyncResultSink(std::unique_ptr<ResultSink> sink)
+    : sink(std::move(sink)), thread(&AsyncResultSink::worker, this)
+{
+}
+
+AsyncResultSink::~AsyncResultSink()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    thread.join();
+}
+
+void AsyncResultSink::writeRun(const RunResult &result)
+{
+    push(Task{Task::Kind::Run, result, {}});
+}
+
+void AsyncResultSink::writeSummary(const RunSummary &summary)
+{
+    push(Task{Task::Kind::Summary, {}, summary});
+}
+
+void AsyncResultSink::flush()
+{
+    push(Task{Task::Kind::Flush, {}, {}});
+    std::unique_lock<std::mutex> lock(mutex);
+    drained.wait(lock, [this]
+                 { return pending == 0; });
+}
+
+void AsyncResultSink::push(Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(task));
+        ++pending;
+    }
+    wake.notify_one();
+}
+
+void AsyncResultSink::worker()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        wake.wait(lock, [this]
+                  { return stopping || !queue.empty(); });
+        if (queue.empty())
+            break; // Stopping and fully drained.
+
+        Task task = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+
+        switch (task.kind)
+        {
+        case Task::Kind::Run:
+            sink->writeRun(task.run);
+            break;
+        case Task::Kind::Summary:
+            sink->writeSummary(task.summary);
+            break;
+        case Task::Kind::Flush:
+            sink->flush();
+            break;
+        }
+
+        lock.lock();
+        if (--pending == 0)
+            drained.notify_all();
+    }
+    lock.unlock();
+    sink->flush();
+}
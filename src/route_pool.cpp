@@ -0,0 +1,170 @@
+#include "route_pool.hpp"
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+RoutePool::RoutePool(std::size_t numNodes, std::size_t capacity)
+    : numNodes(0), capacity(std::max<std::size_t>(capacity, 1))
+{
+    reset(numNodes);
+}
+
+void RoutePool::reset(std::size_t nodes, std::uint64_t revision)
+{
+    numNodes = nodes;
+    instanceRevision = revision;
+    entries.clear();
+    index.clear();
+
+    // Fixed seed: the same instance always gets the same keys.
+    std::mt19937_64 rng(0x5EEDC0DEULL);
+    keys.resize(numNodes);
+    checkKeys.resize(numNodes);
+    for (std::size_t i = 0; i < numNodes; ++i)
+    {
+        keys[i] = rng();
+        checkKeys[i] = rng();
+    }
+}
+
+bool RoutePool::add(const std::vector<int> &route, double cost)
+{
+    if (route.empty())
+        return false;
+
+    std::uint64_t hash = 0;
+    std::uint64_t check = 0;
+    for (int customer : route)
+    {
+        hash ^= keys[customer];
+        check += checkKeys[customer];
+    }
+
+    auto found = index.find(hash);
+    if (found != index.end())
+    {
+        Entry &entry = entries[found->second];
+        if (entry.check != check || entry.route.size() != route.size() || cost >= entry.cost)
+            return false;
+        entry.route = route;
+        entry.cost = cost;
+        return true;
+    }
+
+    index.emplace(hash, entries.size());
+    entries.push_back({route, cost, hash, check});
+    if (entries.size() >= capacity + capacity / 4)
+        prune();
+    return true;
+}
+
+bool RoutePool::containsRoute(const std::vector<int> &route) const
+{
+    if (route.empty())
+        return false;
+    std::uint64_t hash = 0;
+    for (int customer : route)
+        hash ^= keys[customer];
+    auto found = index.find(hash);
+    return found != index.end() && entries[found->second].route == route;
+}
+
+void RoutePool::prune()
+{
+    auto ratio = [](const Entry &entry)
+    { return entry.cost / static_cast<double>(entry.route.size()); };
+    std::nth_element(entries.begin(), entries.begin() + static_cast<std::ptrdiff_t>(capacity), entries.end(),
+                     [&](const Entry &a, const Entry &b)
+                     { return ratio(a) < ratio(b); });
+    entries.resize(capacity);
+    index.clear();
+    for (std::size_t i = 0; i < entries.size(); ++i)
+        index.emplace(entries[i].hash, i);
+}
+
+double RoutePool::assemble(std::size_t maxRoutes, double uncoveredPenalty, std::vector<std::vector<int>> &routes) const
+{
+    routes.clear();
+    if (entries.empty() || maxRoutes == 0)
+        return 0.0;
+
+    // owner[c] is the selected entry serving customer c, or -1.
+    std::vector<int> owner(numNodes, -1);
+    std::vector<char> selected(entries.size(), 0);
+    std::size_t numSelected = 0;
+
+    std::vector<std::size_t> order(entries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+              { return entries[a].cost * entries[b].route.size() < entries[b].cost * entries[a].route.size(); });
+
+    auto select = [&](std::size_t e)
+    {
+        selected[e] = 1;
+        ++numSelected;
+        for (int customer : entries[e].route)
+            owner[customer] = static_cast<int>(e);
+    };
+    auto deselect = [&](std::size_t e)
+    {
+        selected[e] = 0;
+        --numSelected;
+        for (int customer : entries[e].route)
+            owner[customer] = -1;
+    };
+
+    // Greedy: cheapest cost per customer first, skipping overlapping routes.
+    for (std::size_t e : order)
+    {
+        if (numSelected == maxRoutes)
+            break;
+        const std::vector<int> &route = entries[e].route;
+        if (std::all_of(route.begin(), route.end(), [&](int customer)
+                        { return owner[customer] < 0; }))
+            select(e);
+    }
+
+    // Local search: swap a route in and the selected routes it overlaps out.
+    std::vector<int> conflicts;
+    bool improved = true;
+    for (int pass = 0; pass < 5 && improved; ++pass)
+    {
+        improved = false;
+        for (std::size_t e : order)
+        {
+            if (selected[e])
+                continue;
+            conflicts.clear();
+            for (int customer : entries[e].route)
+            {
+                int o = owner[customer];
+                if (o >= 0 && std::find(conflicts.begin(), conflicts.end(), o) == conflicts.end())
+                    conflicts.push_back(o);
+            }
+            if (numSelected - conflicts.size() + 1 > maxRoutes)
+                continue;
+
+            double delta = entries[e].cost - uncoveredPenalty * static_cast<double>(entries[e].route.size());
+            for (int o : conflicts)
+                delta += uncoveredPenalty * static_cast<double>(entries[o].route.size()) - entries[o].cost;
+            if (delta < -1e-9)
+            {
+                for (int o : conflicts)
+                    deselect(static_cast<std::size_t>(o));
+                select(e);
+                improved = true;
+            }
+        }
+    }
+
+    double cost = 0.0;
+    for (std::size_t e = 0; e < entries.size(); ++e)
+    {
+        if (selected[e])
+        {
+            routes.push_back(entries[e].route);
+            cost += entries[e].cost;
+        }
+    }
+    return cost;
+}
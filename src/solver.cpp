@@ -0,0 +1,78 @@
+#include "solver.hpp"
+#include <chrono>
+#include <stdexcept>
+
+void configureSolver(GeneticAlgorithm &ga, const SolverConfig &config)
+{
+    if (config.seed != 0)
+        ga.setSeed(config.seed);
+    ga.setMutationMethod(config.mutationMethod, config.ruinRemovalSize);
+    ga.setAdaptiveOperators(config.adaptiveOperators);
+    ga.setEvaluation(config.distanceType, config.constraintType, config.penalties);
+    ga.setSurvivorSelection(config.survivorSelection);
+    if (config.routePool)
+        ga.setRoutePool(config.sharedRoutePool ? config.sharedRoutePool : std::make_shared<RoutePool>(), config.setPartitioningInterval);
+}
+
+SolveResult solve(const VRP &vrp, const SolverConfig &config, const CancellationToken *token)
+{
+    return solve(vrp, {}, config, token);
+}
+
+SolveResult solve(const VRP &vrp, const std::vector<std::vector<std::vector<int>>> &seeds,
+                  const SolverConfig &config, const CancellationToken *token)
+{
+    if (vrp.getNodes().size() < 2)
+        throw std::invalid_argument("VRP instance has no customers.");
+    if (vrp.getNumVehicles() <= 0)
+        throw std::invalid_argument("VRP instance has no vehicles.");
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    auto elapsedMs = [&]
+    { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+    GeneticAlgorithm ga(vrp, config.selectionMethod, config.tournamentSize);
+    configureSolver(ga, config);
+    ga.initializePopulation(seeds, config.populationSize);
+
+    SolveResult result;
+    SolveStatistics &stats = result.statistics;
+    stats.initialCost = ga.getBestSolutionCost();
+    stats.bestCostHistory.reserve(config.generations);
+
+    for (int gen = 0; gen < config.generations; ++gen)
+    {
+        if (token != nullptr && token->isCancelled())
+        {
+            stats.cancelled = true;
+            break;
+        }
+        if (config.timeLimitSeconds > 0.0 && elapsedMs() >= config.timeLimitSeconds * 1000.0)
+        {
+            stats.timedOut = true;
+            break;
+        }
+        ga.run(1);
+        stats.generations++;
+        stats.bestCostHistory.push_back(ga.getBestSolutionCost());
+    }
+
+    result.routes = ga.getBestSolution();
+    result.cost = ga.getBestSolutionCost();
+    stats.elapsedMs = elapsedMs();
+    stats.operators = ga.getOperatorScheduler().getStats();
+    if (const RoutePool *pool = ga.getRoutePool())
+        stats.routePoolSize = pool->size();
+    stats.setPartitioningImprovements = ga.getSetPartitioningImprovements();
+    result.population = ga.getPopulation();
+    return result;
+}
+
+SolveResult solve(std::vector<Node> nodes, int numVehicles, int vehicleCapacity,
+                  const SolverConfig &config, const CancellationToken *token)
+{
+    VRP vrp;
+    vrp.setData(std::move(nodes), numVehicles, vehicleCapacity);
+    return solve(vrp, config, token);
+}
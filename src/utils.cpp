@@ -0,0 +1,75 @@
+#include "utils.hpp"
+#include <cstring>
+
+void appendVarint(std::string &out, std::uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+bool readVarint(const char *&pos, const char *end, std::uint64_t &value)
+{
+    value = 0;
+    const char *p = pos;
+    for (int shift = 0; shift < 64 && p < end; shift += 7)
+    {
+        std::uint8_t byte = static_cast<std::uint8_t>(*p++);
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            pos = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+void encodeSolution(std::string &out, const std::vector<std::vector<int>> &routes, double cost)
+{
+    char raw[sizeof(double)];
+    std::memcpy(raw, &cost, sizeof(double));
+    out.append(raw, sizeof(double));
+
+    appendVarint(out, routes.size());
+    for (const auto &route : routes)
+    {
+        appendVarint(out, route.size());
+        for (int node : route)
+            appendVarint(out, static_cast<std::uint64_t>(node));
+    }
+}
+
+bool decodeSolution(const char *&pos, const char *end, std::vector<std::vector<int>> &routes, double &cost)
+{
+    const char *p = pos;
+    if (end - p < static_cast<std::ptrdiff_t>(sizeof(double)))
+        return false;
+    std::memcpy(&cost, p, sizeof(double));
+    p += sizeof(double);
+
+    std::uint64_t numRoutes = 0;
+    if (!readVarint(p, end, numRoutes) || numRoutes > static_cast<std::uint64_t>(end - p))
+        return false;
+
+    routes.assign(numRoutes, {});
+    for (auto &route : routes)
+    {
+        std::uint64_t length = 0;
+        if (!readVarint(p, end, length) || length > static_cast<std::uint64_t>(end - p))
+            return false;
+        route.resize(length);
+        for (auto &node : route)
+        {
+            std::uint64_t value = 0;
+            if (!readVarint(p, end, value))
+                return false;
+            node = static_cast<int>(value);
+        }
+    }
+    pos = p;
+    return true;
+}
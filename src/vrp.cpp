@@ -4,8 +4,19 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
 #include <string>
 
+// Returns a revision number not used by any VRP of this process before.
+static std::uint64_t nextRevision()
+{
+    static std::atomic<std::uint64_t> counter{0};
+    return ++counter;
+}
+
 // Helper function to trim whitespace from both ends of a string.
 static inline std::string trim(const std::string &s)
 {
@@ -25,6 +36,8 @@ void VRP::loadData(const std::string &filename)
         return;
     }
     nodes.clear();
+    distanceFile.reset();
+    durationFile.reset();
     std::string line;
     bool vehicleSection = false;
     bool customerSection = false;
@@ -55,6 +68,8 @@ void VRP::loadData(const std::string &filename)
             std::istringstream iss(trimmedLine);
             if (iss >> numVehicles)
             {
+                if (!(iss >> vehicleCapacity))
+                    vehicleCapacity = 0;
                 vehicleSection = false; // Done reading VEHICLE section.
                 continue;
             }
@@ -99,11 +114,21 @@ void VRP::loadData(const std::string &filename)
             node.x = x;
             node.y = y;
             node.demand = demand;
+
+            double readyTime, dueDate, serviceTime;
+            if (iss >> readyTime >> dueDate >> serviceTime)
+            {
+                node.readyTime = readyTime;
+                node.dueDate = dueDate;
+                node.serviceTime = serviceTime;
+            }
             nodes.push_back(node);
         }
     }
     infile.close();
 
+    buildCaches();
+
     std::cout << "Loaded " << nodes.size() << " customer nodes from " << filename << std::endl;
     std::cout << "Number of vehicles: " << numVehicles << std::endl;
 }
@@ -121,19 +146,351 @@ double VRP::computeRouteCost(const std::vector<int> &route) const
     }
 
     double totalCost = 0.0;
-    totalCost += distance(nodes[0], nodes[route[0]]);
+    totalCost += dist(0, route[0]);
 
     for (std::size_t i = 1; i < route.size(); ++i)
     {
-        const Node &from = nodes[route[i - 1]];
-        const Node &to = nodes[route[i]];
-        totalCost += distance(from, to);
+        totalCost += dist(route[i - 1], route[i]);
     }
-    totalCost += distance(nodes[route.back()], nodes[0]);
+    totalCost += dist(route.back(), 0);
 
     return totalCost;
 }
 
+void VRP::setData(std::vector<Node> newNodes, int vehicles, int capacity, int numNeighbors)
+{
+    nodes = std::move(newNodes);
+    distanceFile.reset();
+    durationFile.reset();
+    numVehicles = vehicles;
+    vehicleCapacity = capacity;
+    buildCaches(numNeighbors);
+}
+
+void VRP::buildCaches(int numNeighbors)
+{
+    const std::size_t n = nodes.size();
+    xs.resize(n);
+    ys.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        xs[i] = nodes[i].x;
+        ys[i] = nodes[i].y;
+    }
+
+    largeInstance = forceLargeInstance || n > DenseMatrixLimit;
+    distanceMatrix.clear();
+    distanceMatrix.shrink_to_fit();
+    if (!largeInstance && !distanceFile)
+    {
+        distanceMatrix.assign(n * n, 0.0);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            for (std::size_t j = i + 1; j < n; ++j)
+            {
+                double d = distance(nodes[i], nodes[j]);
+                distanceMatrix[i * n + j] = d;
+                distanceMatrix[j * n + i] = d;
+            }
+        }
+    }
+
+    neighborListSize = numNeighbors;
+    buildNeighborLists();
+    revision = nextRevision();
+}
+
+std::vector<int> VRP::applyDelta(const InstanceDelta &delta)
+{
+    if (distanceFile || durationFile)
+        throw std::logic_error("Instance deltas cannot patch external matrices; load the updated matrices instead.");
+    const std::size_t oldSize = nodes.size();
+    for (const auto &move : delta.moved)
+    {
+        if (move.first < 0 || static_cast<std::size_t>(move.first) >= oldSize)
+            throw std::invalid_argument("Moved node index out of range.");
+    }
+    std::vector<int> removed = delta.removed;
+    for (int index : removed)
+    {
+        if (index <= 0 || static_cast<std::size_t>(index) >= oldSize)
+            throw std::invalid_argument("Removed customer index out of range.");
+    }
+
+    std::vector<char> changed(oldSize, 0);
+    for (const auto &move : delta.moved)
+    {
+        nodes[move.first] = move.second;
+        changed[move.first] = 1;
+    }
+
+    // origin[i] is the previous index of the node now at i, -1 for added nodes.
+    std::vector<int> indexMap(oldSize);
+    std::iota(indexMap.begin(), indexMap.end(), 0);
+    std::vector<int> origin = indexMap;
+
+    // Descending order keeps the last node alive when it is swapped in.
+    std::sort(removed.begin(), removed.end(), std::greater<int>());
+    removed.erase(std::unique(removed.begin(), removed.end()), removed.end());
+    for (int index : removed)
+    {
+        std::size_t last = nodes.size() - 1;
+        indexMap[origin[index]] = -1;
+        if (static_cast<std::size_t>(index) != last)
+        {
+            nodes[index] = nodes[last];
+            origin[index] = origin[last];
+            indexMap[origin[index]] = index;
+        }
+        nodes.pop_back();
+        origin.pop_back();
+    }
+    for (const Node &node : delta.added)
+    {
+        nodes.push_back(node);
+        origin.push_back(-1);
+    }
+
+    const std::size_t n = nodes.size();
+    bool wasLarge = largeInstance;
+    if (wasLarge || forceLargeInstance || n > DenseMatrixLimit)
+    {
+        buildCaches(neighborListSize);
+        return indexMap;
+    }
+
+    xs.resize(n);
+    ys.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        xs[i] = nodes[i].x;
+        ys[i] = nodes[i].y;
+    }
+
+    // Copy the distances between unchanged nodes, recompute the rest.
+    std::vector<double> oldMatrix = std::move(distanceMatrix);
+    distanceMatrix.assign(n * n, 0.0);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        bool rowKept = origin[i] >= 0 && !changed[origin[i]];
+        const double *oldRow = rowKept ? &oldMatrix[static_cast<std::size_t>(origin[i]) * oldSize] : nullptr;
+        double *row = &distanceMatrix[i * n];
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            if (rowKept && origin[j] >= 0 && !changed[origin[j]])
+                row[j] = oldRow[origin[j]];
+            else if (i != j)
+                row[j] = distance(nodes[i], nodes[j]);
+        }
+    }
+
+    buildNeighborLists();
+    revision = nextRevision();
+    return indexMap;
+}
+
+std::vector<std::vector<int>> VRP::remapRoutes(const std::vector<std::vector<int>> &routes, const std::vector<int> &indexMap,
+                                               const InstanceDelta *delta)
+{
+    std::vector<int> map = indexMap;
+    if (delta != nullptr)
+    {
+        for (const auto &move : delta->moved)
+        {
+            if (move.first > 0 && static_cast<std::size_t>(move.first) < map.size())
+                map[move.first] = -1;
+        }
+    }
+
+    std::vector<std::vector<int>> mapped(routes.size());
+    for (std::size_t r = 0; r < routes.size(); ++r)
+    {
+        mapped[r].reserve(routes[r].size());
+        for (int customer : routes[r])
+        {
+            if (customer >= 0 && static_cast<std::size_t>(customer) < map.size() && map[customer] > 0)
+                mapped[r].push_back(map[customer]);
+        }
+    }
+    return mapped;
+}
+
+void VRP::buildNeighborLists()
+{
+    const std::size_t n = nodes.size();
+    neighbors.assign(n, {});
+    neighborDistances.assign(n, {});
+    incomingNeighbors.clear();
+    std::size_t k = std::min<std::size_t>(std::max(neighborListSize, 0), n > 1 ? n - 2 : 0);
+    if (k == 0)
+        return;
+    if (distanceFile)
+    {
+        // The grid search relies on Euclidean distances.
+        buildNeighborListsFromMatrix(k);
+        return;
+    }
+
+    // Bucket the customers into a uniform grid with about two customers per cell.
+    double minX = xs[0], maxX = xs[0], minY = ys[0], maxY = ys[0];
+    for (std::size_t i = 1; i < n; ++i)
+    {
+        minX = std::min(minX, xs[i]);
+        maxX = std::max(maxX, xs[i]);
+        minY = std::min(minY, ys[i]);
+        maxY = std::max(maxY, ys[i]);
+    }
+    int gridSize = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(n) / 2.0)));
+    double cellSize = std::max({(maxX - minX) / gridSize, (maxY - minY) / gridSize, 1e-9});
+    auto cellOf = [&](double v, double lo)
+    { return std::min(gridSize - 1, static_cast<int>((v - lo) / cellSize)); };
+
+    std::vector<int> cellStart(static_cast<std::size_t>(gridSize) * gridSize + 1, 0);
+    std::vector<int> cellNodes(n > 0 ? n - 1 : 0);
+    for (std::size_t j = 1; j < n; ++j)
+        cellStart[cellOf(ys[j], minY) * gridSize + cellOf(xs[j], minX) + 1]++;
+    for (std::size_t c = 1; c < cellStart.size(); ++c)
+        cellStart[c] += cellStart[c - 1];
+    std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    for (std::size_t j = 1; j < n; ++j)
+        cellNodes[fill[cellOf(ys[j], minY) * gridSize + cellOf(xs[j], minX)]++] = static_cast<int>(j);
+
+    // Search rings of cells around every node until the k-th nearest customer
+    // is closer than anything an unvisited ring could contain.
+    std::vector<std::pair<double, int>> heap;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        heap.clear();
+        int cx = cellOf(xs[i], minX);
+        int cy = cellOf(ys[i], minY);
+        for (int ring = 0; ring < gridSize; ++ring)
+        {
+            for (int gy = cy - ring; gy <= cy + ring; ++gy)
+            {
+                if (gy < 0 || gy >= gridSize)
+                    continue;
+                bool edgeRow = gy == cy - ring || gy == cy + ring;
+                for (int gx = cx - ring; gx <= cx + ring; gx += edgeRow ? 1 : 2 * ring)
+                {
+                    if (gx >= 0 && gx < gridSize)
+                    {
+                        int cell = gy * gridSize + gx;
+                        for (int c = cellStart[cell]; c < cellStart[cell + 1]; ++c)
+                        {
+                            int j = cellNodes[c];
+                            if (static_cast<std::size_t>(j) == i)
+                                continue;
+                            double d = dist(static_cast<int>(i), j);
+                            if (heap.size() < k)
+                            {
+                                heap.emplace_back(d, j);
+                                std::push_heap(heap.begin(), heap.end());
+                            }
+                            else if (d < heap.front().first)
+                            {
+                                std::pop_heap(heap.begin(), heap.end());
+                                heap.back() = {d, j};
+                                std::push_heap(heap.begin(), heap.end());
+                            }
+                        }
+                    }
+                    if (ring == 0)
+                        break;
+                }
+            }
+            if (heap.size() == k && heap.front().first <= ring * cellSize)
+                break;
+        }
+
+        std::sort_heap(heap.begin(), heap.end());
+        neighbors[i].reserve(heap.size());
+        neighborDistances[i].reserve(heap.size());
+        for (const auto &entry : heap)
+        {
+            neighborDistances[i].push_back(entry.first);
+            neighbors[i].push_back(entry.second);
+        }
+    }
+}
+
+void VRP::buildNeighborListsFromMatrix(std::size_t k)
+{
+    const std::size_t n = nodes.size();
+    // Incoming lists keep one bounded max-heap per column, filled during the row scan.
+    const bool incoming = !distanceFile->isSymmetric();
+    std::vector<std::vector<std::pair<double, int>>> columns(incoming ? n : 0);
+    std::vector<std::pair<double, int>> row;
+    row.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        row.clear();
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            if (j == i)
+                continue;
+            double distance = dist(static_cast<int>(i), static_cast<int>(j));
+            if (j > 0)
+                row.emplace_back(distance, static_cast<int>(j));
+            if (incoming && i > 0)
+            {
+                std::vector<std::pair<double, int>> &heap = columns[j];
+                if (heap.size() < k)
+                {
+                    heap.emplace_back(distance, static_cast<int>(i));
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                else if (distance < heap.front().first)
+                {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = {distance, static_cast<int>(i)};
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+        }
+        std::size_t count = std::min(k, row.size());
+        std::partial_sort(row.begin(), row.begin() + static_cast<std::ptrdiff_t>(count), row.end());
+        neighbors[i].reserve(count);
+        neighborDistances[i].reserve(count);
+        for (std::size_t c = 0; c < count; ++c)
+        {
+            neighborDistances[i].push_back(row[c].first);
+            neighbors[i].push_back(row[c].second);
+        }
+    }
+
+    if (!incoming)
+        return;
+    incomingNeighbors.assign(n, {});
+    for (std::size_t j = 0; j < n; ++j)
+    {
+        std::sort_heap(columns[j].begin(), columns[j].end());
+        incomingNeighbors[j].reserve(columns[j].size());
+        for (const auto &entry : columns[j])
+            incomingNeighbors[j].push_back(entry.second);
+    }
+}
+
+std::shared_ptr<const MappedMatrix> VRP::mapMatrix(const std::string &path) const
+{
+    auto matrix = std::make_shared<const MappedMatrix>(path);
+    if (matrix->size() != nodes.size())
+        throw std::invalid_argument("Matrix file " + path + " has " + std::to_string(matrix->size()) + " nodes, the instance has " +
+                                    std::to_string(nodes.size()) + ".");
+    return matrix;
+}
+
+void VRP::loadDistanceMatrix(const std::string &path)
+{
+    distanceFile = mapMatrix(path);
+    buildCaches(neighborListSize);
+}
+
+void VRP::loadDurationMatrix(const std::string &path)
+{
+    durationFile = mapMatrix(path);
+    revision = nextRevision();
+}
+
 const std::vector<Node> &VRP::getNodes() const
 {
     return nodes;
@@ -0,0 +1,625 @@
+// Tests of the solver library, through its public API.
+//
+// Usage: test_vrp [test_name]  (all tests when no name is given)
+
+#include "vrp.hpp"
+#include "solver.hpp"
+#include "evaluation.hpp"
+#include "island.hpp"
+#include "mapped_matrix.hpp"
+#include "result_sink.hpp"
+#include "route_pool.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+static int failures = 0;
+static std::string selfPath; ///< Path of this executable, the worker command of the island tests.
+
+#define CHECK(condition)                                                                  \
+    do                                                                                    \
+    {                                                                                     \
+        if (!(condition))                                                                 \
+        {                                                                                 \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++failures;                                                                   \
+        }                                                                                 \
+    } while (0)
+
+// Random CVRP instance: depot in the middle, customers in a 100 x 100 square.
+static std::vector<Node> randomNodes(int customers, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coord(0.0, 100.0);
+    std::uniform_int_distribution<int> demand(1, 10);
+    std::vector<Node> nodes;
+    nodes.push_back({0, 50.0, 50.0, 0});
+    for (int i = 1; i <= customers; ++i)
+        nodes.push_back({i, coord(rng), coord(rng), demand(rng)});
+    return nodes;
+}
+
+static VRP randomInstance(int customers, unsigned int seed)
+{
+    VRP vrp;
+    vrp.setData(randomNodes(customers, seed), customers / 5 + 1, 50, 20);
+    return vrp;
+}
+
+static std::string temporaryPath(const std::string &name)
+{
+    return "/tmp/vrp_ea_test_" + std::to_string(::getpid()) + "_" + name;
+}
+
+// Every customer exactly once, nothing else.
+static bool isPermutation(const std::vector<std::vector<int>> &routes, std::size_t numNodes)
+{
+    std::vector<int> seen(numNodes, 0);
+    for (const auto &route : routes)
+    {
+        for (int customer : route)
+        {
+            if (customer <= 0 || static_cast<std::size_t>(customer) >= numNodes || seen[customer]++)
+                return false;
+        }
+    }
+    return std::count(seen.begin() + 1, seen.end(), 1) == static_cast<std::ptrdiff_t>(numNodes - 1);
+}
+
+static void testCancellation()
+{
+    VRP vrp = randomInstance(60, 1);
+    SolverConfig config;
+    config.populationSize = 20;
+    config.generations = 1000000;
+
+    CancellationToken token;
+    token.cancel();
+    SolveResult cancelled = solve(vrp, config, &token);
+    CHECK(cancelled.statistics.cancelled);
+    CHECK(cancelled.statistics.generations == 0);
+    CHECK(isPermutation(cancelled.routes, vrp.getNodes().size()));
+
+    config.timeLimitSeconds = 0.2;
+    SolveResult timed = solve(vrp, config);
+    CHECK(timed.statistics.timedOut);
+    CHECK(!timed.statistics.cancelled);
+    CHECK(timed.statistics.generations > 0);
+    CHECK(timed.statistics.generations < config.generations);
+    CHECK(timed.statistics.elapsedMs < 5000.0);
+    CHECK(isPermutation(timed.routes, vrp.getNodes().size()));
+}
+
+static void testSeedReproducibility()
+{
+    VRP vrp = randomInstance(50, 2);
+    SolverConfig config;
+    config.populationSize = 20;
+    config.generations = 30;
+    config.adaptiveOperators = false;
+    config.constraintType = ConstraintType::Capacity;
+    config.seed = 7;
+
+    SolveResult first = solve(vrp, config);
+    SolveResult second = solve(vrp, config);
+    CHECK(first.cost == second.cost);
+    CHECK(first.routes == second.routes);
+    CHECK(first.statistics.bestCostHistory == second.statistics.bestCostHistory);
+    CHECK(isPermutation(first.routes, vrp.getNodes().size()));
+}
+
+static void testBinaryRoundTrip()
+{
+    std::vector<std::vector<int>> routes = {{1, 2, 300}, {}, {70000, 5}};
+    std::string buffer;
+    encodeSolution(buffer, routes, 1234.5678);
+    std::vector<std::vector<int>> decoded;
+    double cost = 0.0;
+    const char *pos = buffer.data();
+    CHECK(decodeSolution(pos, buffer.data() + buffer.size(), decoded, cost));
+    CHECK(pos == buffer.data() + buffer.size());
+    CHECK(decoded == routes);
+    CHECK(cost == 1234.5678);
+
+    pos = buffer.data();
+    CHECK(!decodeSolution(pos, buffer.data() + buffer.size() - 1, decoded, cost));
+
+    // A BinaryResultSink file: magic, version, then run number and solution per run.
+    std::string path = temporaryPath("results.bin");
+    {
+        BinaryResultSink sink(path);
+        for (int run = 1; run <= 3; ++run)
+        {
+            RunResult result;
+            result.run = run;
+            result.cost = 100.0 / run;
+            result.routes = {{run, run + 1}, {run + 2}};
+            sink.writeRun(result);
+        }
+        sink.flush();
+    }
+    std::ifstream in(path, std::ios::binary);
+    std::string file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::remove(path.c_str());
+    CHECK(file.compare(0, 5, std::string("VRPS\x01", 5)) == 0);
+    pos = file.data() + 5;
+    const char *end = file.data() + file.size();
+    for (int run = 1; run <= 3; ++run)
+    {
+        std::uint64_t number = 0;
+        CHECK(readVarint(pos, end, number));
+        CHECK(number == static_cast<std::uint64_t>(run));
+        CHECK(decodeSolution(pos, end, decoded, cost));
+        CHECK(cost == 100.0 / run);
+        CHECK((decoded == std::vector<std::vector<int>>{{run, run + 1}, {run + 2}}));
+    }
+    CHECK(pos == end);
+}
+
+// Route cost recomputed leg by leg from VRP::dist() with the policy's rounding.
+template <class Distance>
+static double expectedRouteCost(const VRP &vrp, const std::vector<int> &route)
+{
+    typename Distance::sum_type sum = 0;
+    int prev = 0;
+    for (int customer : route)
+    {
+        sum += Distance::convert(vrp.dist(prev, customer));
+        prev = customer;
+    }
+    sum += Distance::convert(vrp.dist(prev, 0));
+    return Distance::toCost(sum);
+}
+
+template <class Distance>
+static void checkTwoOpt(const VRP &vrp, DistanceType type, const std::string &label)
+{
+    auto core = makeEvaluationCore(vrp, type, ConstraintType::Unconstrained);
+    std::mt19937 rng(11);
+    const double tolerance = std::is_same_v<Distance, FloatDistance> ? 1e-2 : 1e-6;
+    std::vector<int> customers;
+    for (std::size_t i = 1; i < vrp.getNodes().size(); ++i)
+        customers.push_back(static_cast<int>(i));
+
+    for (int trial = 0; trial < 5; ++trial)
+    {
+        std::shuffle(customers.begin(), customers.end(), rng);
+        std::vector<int> route(customers.begin(), customers.begin() + 25);
+        std::vector<int> original = route;
+        double before = core->routeCost(route);
+        CHECK(std::abs(before - expectedRouteCost<Distance>(vrp, route)) <= tolerance);
+
+        core->twoOpt(route);
+        double after = core->routeCost(route);
+        if (std::abs(after - expectedRouteCost<Distance>(vrp, route)) > tolerance || after > before + tolerance)
+            std::fprintf(stderr, "2-opt on %s: %f -> %f\n", label.c_str(), before, after);
+        CHECK(std::abs(after - expectedRouteCost<Distance>(vrp, route)) <= tolerance);
+        CHECK(after <= before + tolerance);
+        std::sort(original.begin(), original.end());
+        std::vector<int> sorted = route;
+        std::sort(sorted.begin(), sorted.end());
+        CHECK(sorted == original);
+
+        // The full neighborhood is searched on dense instances: no reversal may improve.
+        if (!vrp.isLargeInstance())
+        {
+            for (std::size_t i = 0; i + 1 < route.size(); ++i)
+            {
+                for (std::size_t j = i + 1; j < route.size(); ++j)
+                {
+                    std::vector<int> reversed = route;
+                    std::reverse(reversed.begin() + i, reversed.begin() + j + 1);
+                    CHECK(expectedRouteCost<Distance>(vrp, reversed) >= after - tolerance);
+                }
+            }
+        }
+    }
+}
+
+static void checkTwoOptAllPolicies(const VRP &vrp, const std::string &label)
+{
+    checkTwoOpt<DoubleDistance>(vrp, DistanceType::Double, label + "/double");
+    checkTwoOpt<FloatDistance>(vrp, DistanceType::Float, label + "/float");
+    checkTwoOpt<ScaledIntegerDistance<10, true>>(vrp, DistanceType::ScaledInteger, label + "/scaled");
+    checkTwoOpt<ScaledIntegerDistance<1, false>>(vrp, DistanceType::RoundedInteger, label + "/rounded");
+}
+
+static void testTwoOpt()
+{
+    VRP dense = randomInstance(60, 3);
+    checkTwoOptAllPolicies(dense, "dense");
+
+    VRP large;
+    large.setLargeInstanceMode(true);
+    large.setData(randomNodes(60, 3), 13, 50, 20);
+    checkTwoOptAllPolicies(large, "large");
+
+    // Asymmetric road-network style matrix: Euclidean plus a one-way detour.
+    const std::size_t n = dense.getNodes().size();
+    std::vector<double> values(n * n);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> detour(0.0, 20.0);
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            values[i * n + j] = i == j ? 0.0 : dense.dist(static_cast<int>(i), static_cast<int>(j)) + detour(rng);
+    for (MatrixValueType type : {MatrixValueType::Float32, MatrixValueType::Float64})
+    {
+        std::string path = temporaryPath("matrix.vrpm");
+        MappedMatrix::write(path, n, values, type, false);
+        VRP asymmetric = randomInstance(60, 3);
+        asymmetric.loadDistanceMatrix(path);
+        VRP largeAsymmetric;
+        largeAsymmetric.setLargeInstanceMode(true);
+        largeAsymmetric.setData(randomNodes(60, 3), 13, 50, 20);
+        largeAsymmetric.loadDistanceMatrix(path);
+        std::remove(path.c_str());
+        CHECK(!asymmetric.isSymmetric());
+        CHECK(largeAsymmetric.isLargeInstance());
+        std::string label = type == MatrixValueType::Float32 ? "asymmetric32" : "asymmetric64";
+        checkTwoOptAllPolicies(asymmetric, label);
+        checkTwoOptAllPolicies(largeAsymmetric, "large/" + label);
+
+        // Incoming lists are sorted by the distance towards the node.
+        for (int node : {0, 1, 30})
+        {
+            const std::vector<int> &incoming = largeAsymmetric.getIncomingNeighbors(node);
+            CHECK(incoming.size() == 20);
+            for (std::size_t i = 0; i < incoming.size(); ++i)
+            {
+                CHECK(incoming[i] != 0 && incoming[i] != node);
+                if (i > 0)
+                    CHECK(largeAsymmetric.dist(incoming[i - 1], node) <= largeAsymmetric.dist(incoming[i], node));
+            }
+        }
+    }
+}
+
+// Time-window cost recomputed with VRP::travelTime(), for double distances.
+static double expectedTimeWindowCost(const VRP &vrp, const std::vector<int> &route, const ConstraintPenalties &penalties)
+{
+    const std::vector<Node> &nodes = vrp.getNodes();
+    double distance = 0.0, time = 0.0, lateness = 0.0;
+    int load = 0, prev = 0;
+    for (int customer : route)
+    {
+        distance += vrp.dist(prev, customer);
+        load += nodes[customer].demand;
+        time = std::max(time + vrp.travelTime(prev, customer), nodes[customer].readyTime);
+        lateness += std::max(0.0, time - nodes[customer].dueDate);
+        time += nodes[customer].serviceTime;
+        prev = customer;
+    }
+    distance += vrp.dist(prev, 0);
+    time += vrp.travelTime(prev, 0);
+    lateness += std::max(0.0, time - nodes[0].dueDate);
+    return distance + penalties.capacity * std::max(0, load - vrp.getVehicleCapacity()) + penalties.lateness * lateness;
+}
+
+static void testTravelTimes()
+{
+    std::vector<Node> nodes = randomNodes(30, 4);
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<double> due(50.0, 400.0);
+    for (std::size_t i = 1; i < nodes.size(); ++i)
+    {
+        nodes[i].dueDate = due(rng);
+        nodes[i].serviceTime = 5.0;
+    }
+    nodes[0].dueDate = 1000.0;
+    VRP vrp;
+    vrp.setData(nodes, 7, 50, 20);
+
+    std::vector<int> route(30);
+    for (int i = 0; i < 30; ++i)
+        route[i] = i + 1;
+    std::shuffle(route.begin(), route.end(), rng);
+    ConstraintPenalties penalties;
+
+    // Without a travel-time matrix the travel times are the distances.
+    auto core = makeEvaluationCore(vrp, DistanceType::Double, ConstraintType::TimeWindows, penalties);
+    CHECK(std::abs(core->routeCost(route) - expectedTimeWindowCost(vrp, route, penalties)) <= 1e-6);
+
+    // Slow one-way travel times: lateness grows while the distance stays the same.
+    const std::size_t n = nodes.size();
+    std::vector<double> durations(n * n);
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            durations[i * n + j] = i == j ? 0.0 : 3.0 * vrp.dist(static_cast<int>(i), static_cast<int>(j)) + (i < j ? 1.0 : 0.0);
+    double withoutDurations = core->routeCost(route);
+    for (MatrixValueType type : {MatrixValueType::Float32, MatrixValueType::Float64})
+    {
+        std::string path = temporaryPath("durations.vrpm");
+        MappedMatrix::write(path, n, durations, type, false);
+        VRP timed = vrp;
+        timed.loadDurationMatrix(path);
+        std::remove(path.c_str());
+        CHECK(timed.hasDurationMatrix());
+        auto timedCore = makeEvaluationCore(timed, DistanceType::Double, ConstraintType::TimeWindows, penalties);
+        double cost = timedCore->routeCost(route);
+        CHECK(std::abs(cost - expectedTimeWindowCost(timed, route, penalties)) <= 1e-6 * cost);
+        CHECK(cost > withoutDurations);
+    }
+}
+
+static void testApplyDelta()
+{
+    VRP vrp = randomInstance(40, 4);
+    const std::vector<Node> before = vrp.getNodes();
+    std::uint64_t revision = vrp.getRevision();
+
+    InstanceDelta delta;
+    delta.removed = {3, 40, 17};
+    delta.added.push_back({100, 10.0, 90.0, 4});
+    delta.added.push_back({101, 80.0, 5.0, 6});
+    Node moved = before[8];
+    moved.x = 1.0;
+    moved.y = 2.0;
+    delta.moved.push_back({8, moved});
+
+    std::vector<int> indexMap = vrp.applyDelta(delta);
+    const std::vector<Node> &after = vrp.getNodes();
+    CHECK(vrp.getRevision() != revision);
+    CHECK(indexMap.size() == before.size());
+    CHECK(after.size() == before.size() - 3 + 2);
+    CHECK(indexMap[0] == 0);
+    for (std::size_t i = 0; i < before.size(); ++i)
+    {
+        bool removed = std::find(delta.removed.begin(), delta.removed.end(), static_cast<int>(i)) != delta.removed.end();
+        CHECK((indexMap[i] < 0) == removed);
+        if (!removed)
+            CHECK(after[indexMap[i]].id == before[i].id);
+    }
+    CHECK(after[indexMap[8]].x == 1.0 && after[indexMap[8]].y == 2.0);
+    CHECK(after[after.size() - 2].id == 100 && after.back().id == 101);
+
+    // The patched matrix and neighbor lists equal a full rebuild.
+    VRP rebuilt;
+    rebuilt.setData(after, vrp.getNumVehicles(), vrp.getVehicleCapacity(), 20);
+    for (std::size_t i = 0; i < after.size(); ++i)
+    {
+        for (std::size_t j = 0; j < after.size(); ++j)
+            CHECK(std::abs(vrp.dist(static_cast<int>(i), static_cast<int>(j)) - rebuilt.dist(static_cast<int>(i), static_cast<int>(j))) < 1e-9);
+        CHECK(vrp.getNeighbors(static_cast<int>(i)) == rebuilt.getNeighbors(static_cast<int>(i)));
+    }
+
+    // Removed and moved customers are dropped from the remapped routes.
+    std::vector<std::vector<int>> routes = {{1, 3, 8, 40}, {17}, {39, 2}};
+    std::vector<std::vector<int>> remapped = VRP::remapRoutes(routes, indexMap, &delta);
+    CHECK(remapped.size() == routes.size());
+    CHECK((remapped[0] == std::vector<int>{indexMap[1]}));
+    CHECK(remapped[1].empty());
+    CHECK((remapped[2] == std::vector<int>{indexMap[39], indexMap[2]}));
+    std::vector<std::vector<int>> kept = VRP::remapRoutes(routes, indexMap);
+    CHECK((kept[0] == std::vector<int>{indexMap[1], indexMap[8]}));
+
+    // A warm start from the remapped routes serves every customer of the new instance.
+    SolverConfig config;
+    config.populationSize = 10;
+    config.generations = 5;
+    SolveResult warm = solve(vrp, {remapped}, config);
+    CHECK(isPermutation(warm.routes, after.size()));
+}
+
+static void testRoutePoolAssemble()
+{
+    const std::size_t numNodes = 41;
+    RoutePool pool(numNodes);
+    std::mt19937 rng(6);
+    std::vector<int> customers;
+    for (std::size_t i = 1; i < numNodes; ++i)
+        customers.push_back(static_cast<int>(i));
+    std::uniform_int_distribution<int> length(1, 8);
+    std::uniform_real_distribution<double> cost(10.0, 100.0);
+    for (int r = 0; r < 400; ++r)
+    {
+        std::shuffle(customers.begin(), customers.end(), rng);
+        std::vector<int> route(customers.begin(), customers.begin() + length(rng));
+        pool.add(route, cost(rng));
+    }
+    CHECK(pool.size() > 0);
+
+    for (std::size_t maxRoutes : {3u, 8u, 40u})
+    {
+        std::vector<std::vector<int>> routes;
+        double total = pool.assemble(maxRoutes, 50.0, routes);
+        CHECK(routes.size() <= maxRoutes);
+        CHECK(!routes.empty());
+        std::vector<int> seen(numNodes, 0);
+        double sum = 0.0;
+        for (const auto &route : routes)
+        {
+            CHECK(pool.containsRoute(route));
+            for (int customer : route)
+                CHECK(seen[customer]++ == 0);
+            for (const RoutePool::Entry &entry : pool.getEntries())
+                if (entry.route == route)
+                    sum += entry.cost;
+        }
+        CHECK(std::abs(sum - total) < 1e-9);
+    }
+
+    pool.reset(numNodes, 99);
+    CHECK(pool.size() == 0);
+    CHECK(pool.getInstanceRevision() == 99);
+}
+
+// Instance and configuration shared by the island coordinators and their workers.
+static VRP islandInstance()
+{
+    return randomInstance(40, 9);
+}
+
+static SolverConfig islandConfig()
+{
+    SolverConfig config;
+    config.populationSize = 15;
+    config.generations = 40;
+    config.constraintType = ConstraintType::Capacity;
+    config.seed = 3;
+    return config;
+}
+
+// Counts the shared-memory segments of this process that are still around.
+static int leftoverSegments()
+{
+    std::string prefix = "vrp_ea_" + std::to_string(::getpid()) + "_";
+    int count = 0;
+    if (DIR *dir = ::opendir("/dev/shm"))
+    {
+        while (dirent *entry = ::readdir(dir))
+            count += std::strncmp(entry->d_name, prefix.c_str(), prefix.size()) == 0;
+        ::closedir(dir);
+    }
+    return count;
+}
+
+static void testSharedMemoryIslands()
+{
+    VRP vrp = islandInstance();
+    SolverConfig config = islandConfig();
+
+    // Two concurrent calls in one process get separate segments.
+    SolveResult results[2];
+    bool threw[2] = {false, false};
+    std::vector<std::thread> callers;
+    for (int call = 0; call < 2; ++call)
+    {
+        callers.emplace_back([&, call]
+                             {
+            try
+            {
+                results[call] = solveLocalIslands(vrp, config, 3, {selfPath}, 5);
+            }
+            catch (const std::exception &error)
+            {
+                std::fprintf(stderr, "solveLocalIslands: %s\n", error.what());
+                threw[call] = true;
+            } });
+    }
+    for (std::thread &caller : callers)
+        caller.join();
+    for (int call = 0; call < 2; ++call)
+    {
+        CHECK(!threw[call]);
+        CHECK(isPermutation(results[call].routes, vrp.getNodes().size()));
+        CHECK(results[call].statistics.generations == config.generations);
+    }
+    CHECK(leftoverSegments() == 0);
+}
+
+static void testTcpIslands()
+{
+    VRP vrp = islandInstance();
+    SolverConfig config = islandConfig();
+    SolverConfig workerConfig = config;
+    workerConfig.generations = 1000000; // Only the coordinator's stop signal ends the workers.
+    const int port = 20000 + ::getpid() % 20000;
+
+    // Workers 2 and 3 score without capacity penalties, so their costs are not
+    // comparable: worker 2 says so and is rejected, worker 3 greets with the
+    // coordinator's fingerprint and is only caught by the re-scoring.
+    SolverConfig otherConfig = workerConfig;
+    otherConfig.constraintType = ConstraintType::Unconstrained;
+    CHECK(islandFingerprint(vrp, config) == islandFingerprint(vrp, workerConfig));
+    CHECK(islandFingerprint(vrp, config) != islandFingerprint(vrp, otherConfig));
+    CHECK(islandFingerprint(vrp, config) != islandFingerprint(randomInstance(40, 10), config));
+
+    SolveResult workers[4];
+    bool threw[4] = {false, false, false, false};
+    std::vector<std::thread> threads;
+    for (int w = 0; w < 4; ++w)
+    {
+        threads.emplace_back([&, w]
+                             {
+            try
+            {
+                SolverConfig own = w < 2 ? workerConfig : otherConfig;
+                own.seed += static_cast<unsigned int>(w + 1);
+                if (w < 3)
+                {
+                    workers[w] = runTcpWorker(vrp, own, "127.0.0.1", port, 5);
+                }
+                else
+                {
+                    TcpWorker channel("127.0.0.1", port, islandFingerprint(vrp, config));
+                    workers[w] = runIsland(vrp, own, channel, 5);
+                }
+            }
+            catch (const std::exception &error)
+            {
+                std::fprintf(stderr, "runTcpWorker: %s\n", error.what());
+                threw[w] = true;
+            } });
+    }
+    SolveResult coordinator = runTcpCoordinator(vrp, config, port, 3, 5);
+    for (std::thread &thread : threads)
+        thread.join();
+
+    CHECK(isPermutation(coordinator.routes, vrp.getNodes().size()));
+    // The result is scored by the coordinator, whatever the workers reported.
+    auto core = makeEvaluationCore(vrp, config.distanceType, config.constraintType, config.penalties);
+    CHECK(std::abs(coordinator.cost - core->solutionCost(coordinator.routes)) <= 1e-6);
+    for (int w = 0; w < 4; ++w)
+    {
+        CHECK(!threw[w]);
+        CHECK(workers[w].statistics.cancelled);
+        CHECK(workers[w].statistics.generations < workerConfig.generations);
+    }
+    // The coordinator merges the final elites of the workers.
+    for (int w = 0; w < 2; ++w)
+        CHECK(coordinator.cost <= workers[w].cost + 1e-9);
+}
+
+int main(int argc, char *argv[])
+{
+    selfPath = argv[0];
+    if (argc > 1 && std::strncmp(argv[1], SharedMemoryIslandOption, std::strlen(SharedMemoryIslandOption)) == 0)
+    {
+        // Started by solveLocalIslands() in testSharedMemoryIslands().
+        runSharedMemoryWorker(islandInstance(), islandConfig(), argv[1] + std::strlen(SharedMemoryIslandOption));
+        return 0;
+    }
+
+    const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+        {"cancellation", testCancellation},
+        {"seed_reproducibility", testSeedReproducibility},
+        {"binary_round_trip", testBinaryRoundTrip},
+        {"two_opt", testTwoOpt},
+        {"travel_times", testTravelTimes},
+        {"apply_delta", testApplyDelta},
+        {"route_pool", testRoutePoolAssemble},
+        {"shared_memory_islands", testSharedMemoryIslands},
+        {"tcp_islands", testTcpIslands},
+    };
+
+    std::string only = argc > 1 ? argv[1] : "";
+    bool found = false;
+    for (const auto &test : tests)
+    {
+        if (!only.empty() && test.first != only)
+            continue;
+        found = true;
+        int failuresBefore = failures;
+        test.second();
+        std::printf("%-22s %s\n", test.first.c_str(), failures == failuresBefore ? "passed" : "FAILED");
+    }
+    if (!found)
+    {
+        std::fprintf(stderr, "Unknown test: %s\n", only.c_str());
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}